@@ -0,0 +1,19 @@
+#include <stddef.h>
+#include "annulation.h"
+
+static _Thread_local const int *drapeau_suivi = NULL;
+
+int methode_annulee(void)
+{
+    return drapeau_suivi && __atomic_load_n(drapeau_suivi, __ATOMIC_RELAXED);
+}
+
+void suivre_annulation(const int *drapeau)
+{
+    drapeau_suivi = drapeau;
+}
+
+void lever_annulation(int *drapeau)
+{
+    __atomic_store_n(drapeau, 1, __ATOMIC_RELAXED);
+}
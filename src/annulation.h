@@ -0,0 +1,21 @@
+#ifndef ANNULATION_H
+#define ANNULATION_H
+
+/*
+ * Annulation coopérative d'une méthode initiale (mode portefeuille,
+ * portefeuille.h). Le thread qui exécute la méthode suit un drapeau ; la
+ * méthode consulte methode_annulee() à chaque étape et, s'il est levé,
+ * s'arrête en laissant une proposition incomplète. Hors portefeuille, aucun
+ * drapeau n'est suivi et methode_annulee() vaut toujours 0.
+ */
+
+// 1 si le drapeau suivi par le thread courant est levé
+int methode_annulee(void);
+
+// Fait suivre au thread courant le drapeau *drapeau (NULL : aucun)
+void suivre_annulation(const int *drapeau);
+
+// Lève le drapeau (depuis n'importe quel thread)
+void lever_annulation(int *drapeau);
+
+#endif
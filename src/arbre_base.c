@@ -0,0 +1,243 @@
+#include <stdlib.h>
+#include "arbre_base.h"
+
+ArbreBase *creer_arbre_base(int n, int m, Arene *a)
+{
+    int total = n + m;
+    size_t taille = (size_t)total * sizeof(int);
+    ArbreBase *t = a ? arene_alloc(a, sizeof(ArbreBase)) : malloc(sizeof(ArbreBase));
+    if (!t)
+        return NULL;
+
+    t->nb_sommets = total;
+    t->nb_fournisseurs = n;
+    t->racine = -1;
+    t->arene = a;
+    if (a) {
+        t->pere = arene_alloc(a, taille);
+        t->prof = arene_alloc(a, taille);
+        t->arc_pere = arene_alloc(a, taille);
+        t->fil = arene_alloc(a, taille);
+        t->fil_prec = arene_alloc(a, taille);
+        t->travail = arene_alloc(a, 2 * taille);
+    } else {
+        t->pere = malloc(taille);
+        t->prof = malloc(taille);
+        t->arc_pere = malloc(taille);
+        t->fil = malloc(taille);
+        t->fil_prec = malloc(taille);
+        t->travail = malloc(2 * taille);
+    }
+    if (!t->pere || !t->prof || !t->arc_pere || !t->fil || !t->fil_prec || !t->travail) {
+        liberer_arbre_base(t);
+        return NULL;
+    }
+    return t;
+}
+
+void liberer_arbre_base(ArbreBase *t)
+{
+    if (!t || t->arene)
+        return;
+    free(t->pere);
+    free(t->prof);
+    free(t->arc_pere);
+    free(t->fil);
+    free(t->fil_prec);
+    free(t->travail);
+    free(t);
+}
+
+void invalider_arbre_base(ArbreBase *t)
+{
+    t->racine = -1;
+}
+
+/*
+ * Parcours en profondeur sans pile : le père sert de retour arrière, et
+ * curseur[u] retient le prochain voisin de u à essayer.
+ */
+int enraciner_arbre(ArbreBase *t, const AdjacenceBase *adj, int racine)
+{
+    int total = t->nb_sommets;
+    int *ordre = t->travail;
+    int *curseur = t->travail + total;
+
+    for (int u = 0; u < total; u++)
+        t->prof[u] = -1;
+
+    int nb = 0;
+    t->pere[racine] = -1;
+    t->arc_pere[racine] = -1;
+    t->prof[racine] = 0;
+    curseur[racine] = adj->debut[racine];
+    ordre[nb++] = racine;
+
+    int u = racine;
+    while (u >= 0) {
+        if (curseur[u] == adj->debut[u + 1]) {
+            u = t->pere[u];
+            continue;
+        }
+        int k = curseur[u]++;
+        int v = adj->voisins[k];
+        if (t->prof[v] >= 0)
+            continue;
+        t->pere[v] = u;
+        t->arc_pere[v] = adj->arc[k];
+        t->prof[v] = t->prof[u] + 1;
+        curseur[v] = adj->debut[v];
+        ordre[nb++] = v;
+        u = v;
+    }
+
+    for (int q = 0; q < nb; q++) {
+        int suivant = ordre[(q + 1) % nb];
+        t->fil[ordre[q]] = suivant;
+        t->fil_prec[suivant] = ordre[q];
+    }
+
+    /* Arbre couvrant : tous les sommets atteints par n + m - 1 arcs */
+    int arbre = (nb == total && adj->debut[total] == 2 * (total - 1));
+    t->racine = arbre ? racine : -1;
+    return nb;
+}
+
+int cycle_arbre(const ArbreBase *t, int i_entree, int j_entree, int *chemin)
+{
+    if (t->racine < 0)
+        return -1;
+
+    // Remontée jusqu'à l'ancêtre commun, en comptant les sommets de chaque côté
+    int a = i_entree, b = t->nb_fournisseurs + j_entree;
+    int nb_a = 0, nb_b = 0;
+    while (t->prof[a] > t->prof[b]) { a = t->pere[a]; nb_a++; }
+    while (t->prof[b] > t->prof[a]) { b = t->pere[b]; nb_b++; }
+    while (a != b) {
+        a = t->pere[a]; nb_a++;
+        b = t->pere[b]; nb_b++;
+    }
+
+    // Côté fournisseur à l'endroit, côté client à rebours depuis la fin
+    int len = nb_a + nb_b + 1;
+    a = i_entree;
+    for (int k = 0; k < nb_a; k++) {
+        chemin[k] = a;
+        a = t->pere[a];
+    }
+    chemin[nb_a] = a;
+    b = t->nb_fournisseurs + j_entree;
+    for (int k = 0; k < nb_b; k++) {
+        chemin[len - 1 - k] = b;
+        b = t->pere[b];
+    }
+    return len;
+}
+
+int arc_dans_arbre(const ArbreBase *t, int i, int j)
+{
+    int c = t->nb_fournisseurs + j;
+    if (t->racine < 0)
+        return -1;
+    if (t->pere[i] == c)
+        return t->arc_pere[i];
+    if (t->pere[c] == i)
+        return t->arc_pere[c];
+    return -1;
+}
+
+/*
+ * Sans l'arc sortant, l'arbre se coupe en deux : le sous-arbre de son
+ * extrémité fille et le reste, qui garde la racine. Le sous-arbre est
+ * raccroché sous l'extrémité de l'arc entrant restée dehors ; sur le chemin
+ * p_0 = dedans, ..., p_k = fille, les pères s'inversent.
+ *
+ * Nouvel ordre préfixe du sous-arbre : pour i = 0..k, le sous-arbre de p_i
+ * privé de celui de p_(i-1), dans l'ordre de fil. Le sous-arbre de p_(i-1)
+ * étant d'un seul tenant dans fil, on le saute en allant directement au
+ * sommet qui le suivait ; chaque sommet n'est vu qu'une fois. Les
+ * profondeurs d'un même groupe se décalent toutes de la même quantité.
+ */
+int pivoter_arbre(ArbreBase *t, int i_entree, int j_entree, int i_sortie, int j_sortie)
+{
+    int n = t->nb_fournisseurs;
+    if (t->racine < 0)
+        return -1;
+
+    int fille;
+    if (t->pere[i_sortie] == n + j_sortie) {
+        fille = i_sortie;
+    } else if (t->pere[n + j_sortie] == i_sortie) {
+        fille = n + j_sortie;
+    } else {
+        t->racine = -1;   // l'arc sortant n'est pas dans l'arbre
+        return -1;
+    }
+
+    // Extrémité de l'arc entrant dans le sous-arbre : remontée bornée par le cycle
+    int x = i_entree;
+    while (t->prof[x] > t->prof[fille])
+        x = t->pere[x];
+    int dedans = (x == fille) ? i_entree : n + j_entree;
+    int dehors = (x == fille) ? n + j_entree : i_entree;
+
+    int avant = t->fil_prec[fille];
+    int *ordre = t->travail;
+    int nb = 0;
+
+    int p = dedans, precedent = -1, apres = -1;
+    int profondeur = t->prof[dehors] + 1;
+    for (;;) {
+        int ancienne = t->prof[p];
+        int decalage = profondeur - ancienne;
+        ordre[nb++] = p;
+        t->prof[p] = profondeur;
+
+        int u = t->fil[p];
+        for (;;) {
+            if (u == precedent)
+                u = apres;   // groupe précédent, déjà rangé
+            if (t->prof[u] <= ancienne)
+                break;
+            ordre[nb++] = u;
+            t->prof[u] += decalage;
+            u = t->fil[u];
+        }
+        apres = u;
+
+        if (p == fille)
+            break;
+        precedent = p;
+        p = t->pere[p];
+        profondeur++;
+    }
+
+    // Le sous-arbre quitte sa place dans fil et suit désormais dehors
+    t->fil[avant] = apres;
+    t->fil_prec[apres] = avant;
+    int suivant = t->fil[dehors];
+    t->fil[dehors] = ordre[0];
+    t->fil_prec[ordre[0]] = dehors;
+    for (int k = 0; k + 1 < nb; k++) {
+        t->fil[ordre[k]] = ordre[k + 1];
+        t->fil_prec[ordre[k + 1]] = ordre[k];
+    }
+    t->fil[ordre[nb - 1]] = suivant;
+    t->fil_prec[suivant] = ordre[nb - 1];
+
+    // Pères inversés ; l'arc entrant prend la place de l'arc sortant
+    int pere_nouveau = dehors, arc_nouveau = t->arc_pere[fille];
+    p = dedans;
+    for (;;) {
+        int pere_ancien = t->pere[p], arc_ancien = t->arc_pere[p];
+        t->pere[p] = pere_nouveau;
+        t->arc_pere[p] = arc_nouveau;
+        if (p == fille)
+            break;
+        pere_nouveau = p;
+        arc_nouveau = arc_ancien;
+        p = pere_ancien;
+    }
+
+    return nb;
+}
@@ -0,0 +1,65 @@
+#ifndef ARBRE_BASE_H
+#define ARBRE_BASE_H
+
+#include "base.h"
+#include "arene.h"
+
+/*
+ * La base enracinée, gardée d'un pivot à l'autre comme dans les codes de
+ * simplexe sur réseau. Sommets : fournisseurs 0..n-1, clients n..n+m-1.
+ *
+ * - pere, prof : père et profondeur de chaque sommet ;
+ * - arc_pere : indice dans la base (b->arcs) de l'arc qui relie un sommet
+ *   à son père, d'où l'arc sortant remplacé sans parcourir la base ;
+ * - fil, fil_prec : ordre préfixe (cyclique) des sommets. Le sous-arbre
+ *   d'un sommet u est u suivi des sommets de fil tant que leur profondeur
+ *   dépasse celle de u.
+ *
+ * Le cycle d'un arc entrant se trouve en remontant ses deux extrémités
+ * jusqu'à leur ancêtre commun (O(longueur du cycle)), et un pivot ne
+ * raccroche que le sous-arbre coupé par l'arc sortant.
+ */
+typedef struct ArbreBase {
+    int nb_sommets;
+    int nb_fournisseurs;
+    int racine;       // -1 : arbre à reconstruire (enraciner_arbre)
+    int *pere;        // -1 pour la racine
+    int *prof;
+    int *arc_pere;    // -1 pour la racine
+    int *fil;
+    int *fil_prec;
+    int *travail;     // 2 x nb_sommets : ordre des parcours, sous-arbre coupé
+    struct Arene *arene;  // arène propriétaire, NULL : malloc
+} ArbreBase;
+
+ArbreBase *creer_arbre_base(int nb_fournisseurs, int nb_clients, Arene *a);
+void liberer_arbre_base(ArbreBase *t);
+
+// Après un changement de base autre qu'un pivot (correction, reconstruction)
+void invalider_arbre_base(ArbreBase *t);
+
+// Enracine en racine la base dont adj est l'adjacence (parcours en
+// profondeur, O(n + m)). Renvoie le nombre de sommets atteints, rangés dans
+// l'ordre préfixe dans t->travail. L'arbre n'est valide (t->racine >= 0)
+// que si la base est un arbre couvrant.
+int enraciner_arbre(ArbreBase *t, const AdjacenceBase *adj, int racine);
+
+// Chemin de F_i_entree à C_j_entree dans l'arbre : chemin[0] = i_entree, ...,
+// dernier = n + j_entree. Renvoie le nombre de sommets, -1 si l'arbre est invalide.
+int cycle_arbre(const ArbreBase *t, int i_entree, int j_entree, int *chemin);
+
+// Indice dans la base de l'arc (i, j), -1 s'il n'est pas dans l'arbre (O(1))
+int arc_dans_arbre(const ArbreBase *t, int i, int j);
+
+/*
+ * pivoter_arbre
+ * - (i_entree, j_entree) remplace (i_sortie, j_sortie), à la même place dans
+ *   la base : le sous-arbre coupé par l'arc sortant est raccroché par l'arc
+ *   entrant (pères inversés sur le chemin, profondeurs et ordre préfixe
+ *   recalculés sur le sous-arbre seul).
+ * - Renvoie le nombre de sommets du sous-arbre, rangés dans t->travail, ou
+ *   -1 si l'arc sortant n'est pas dans l'arbre (l'arbre est alors invalidé).
+ */
+int pivoter_arbre(ArbreBase *t, int i_entree, int j_entree, int i_sortie, int j_sortie);
+
+#endif
@@ -0,0 +1,158 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "arene.h"
+
+#define ALIGNEMENT_ARENE 16
+
+struct BlocArene {
+    BlocArene *precedent;
+    size_t taille;     // octets disponibles dans donnees
+    size_t utilise;
+    char donnees[];
+};
+
+static BlocArene *nouveau_bloc(size_t taille, BlocArene *precedent)
+{
+    BlocArene *bloc = malloc(sizeof(BlocArene) + taille);
+    if (!bloc)
+        return NULL;
+    bloc->precedent = precedent;
+    bloc->taille = taille;
+    bloc->utilise = 0;
+    return bloc;
+}
+
+Arene *creer_arene(size_t taille_initiale)
+{
+    Arene *a = malloc(sizeof(Arene));
+    if (!a)
+        return NULL;
+
+    if (taille_initiale < 4096)
+        taille_initiale = 4096;
+
+    a->courant = nouveau_bloc(taille_initiale, NULL);
+    if (!a->courant) {
+        free(a);
+        return NULL;
+    }
+    a->taille_totale = taille_initiale;
+    a->pic = taille_initiale;
+    return a;
+}
+
+// Libère les blocs chaînés depuis bloc jusqu'à jusqua (exclu) ; renvoie leur taille cumulée
+static size_t liberer_blocs(BlocArene *bloc, const BlocArene *jusqua)
+{
+    size_t taille = 0;
+    while (bloc != jusqua) {
+        BlocArene *precedent = bloc->precedent;
+        taille += bloc->taille;
+        free(bloc);
+        bloc = precedent;
+    }
+    return taille;
+}
+
+void detruire_arene(Arene *a)
+{
+    if (!a) return;
+    liberer_blocs(a->courant, NULL);
+    free(a);
+}
+
+// Décalage à partir duquel placer taille octets alignés dans le bloc, ou -1
+static long long placer(const BlocArene *bloc, size_t taille, size_t alignement)
+{
+    uintptr_t debut = (uintptr_t)(bloc->donnees + bloc->utilise);
+    uintptr_t aligne = (debut + alignement - 1) & ~(uintptr_t)(alignement - 1);
+    size_t decalage = bloc->utilise + (size_t)(aligne - debut);
+
+    if (decalage > bloc->taille || taille > bloc->taille - decalage)
+        return -1;
+    return (long long)decalage;
+}
+
+void *arene_alloc_aligne(Arene *a, size_t taille, size_t alignement)
+{
+    if (alignement < ALIGNEMENT_ARENE)
+        alignement = ALIGNEMENT_ARENE;
+
+    long long decalage = placer(a->courant, taille, alignement);
+    if (decalage < 0) {
+        size_t taille_bloc = 2 * a->courant->taille;
+        if (taille_bloc < taille + alignement)
+            taille_bloc = taille + alignement;
+
+        BlocArene *bloc = nouveau_bloc(taille_bloc, a->courant);
+        if (!bloc)
+            return NULL;
+        a->courant = bloc;
+        a->taille_totale += taille_bloc;
+        if (a->taille_totale > a->pic)
+            a->pic = a->taille_totale;
+        decalage = placer(bloc, taille, alignement);
+    }
+
+    a->courant->utilise = (size_t)decalage + taille;
+    return a->courant->donnees + decalage;
+}
+
+void *arene_alloc(Arene *a, size_t taille)
+{
+    return arene_alloc_aligne(a, taille, ALIGNEMENT_ARENE);
+}
+
+void *arene_calloc(Arene *a, size_t nb, size_t taille)
+{
+    if (taille != 0 && nb > SIZE_MAX / taille)
+        return NULL;
+
+    void *ptr = arene_alloc(a, nb * taille);
+    if (ptr)
+        memset(ptr, 0, nb * taille);
+    return ptr;
+}
+
+MarqueArene arene_marque(const Arene *a)
+{
+    MarqueArene m = { a->courant, a->courant->utilise };
+    return m;
+}
+
+void arene_revenir(Arene *a, MarqueArene m)
+{
+    // Les blocs chaînés après la marque sont rendus ; le pic en garde la
+    // trace pour la consolidation de vider_arene().
+    a->taille_totale -= liberer_blocs(a->courant, m.bloc);
+    a->courant = m.bloc;
+    a->courant->utilise = m.utilise;
+}
+
+void vider_arene(Arene *a)
+{
+    if (!a->courant->precedent && a->courant->taille >= a->pic) {
+        a->courant->utilise = 0;
+        return;
+    }
+
+    // Plusieurs blocs ont été nécessaires : on les remplace par un seul
+    // bloc de la taille du pic, qui suffira aux résolutions semblables
+    BlocArene *unique = nouveau_bloc(a->pic, NULL);
+    if (!unique) {
+        // Pas de mémoire pour regrouper : on garde le premier bloc
+        BlocArene *premier = a->courant;
+        while (premier->precedent)
+            premier = premier->precedent;
+        liberer_blocs(a->courant, premier);
+        a->courant = premier;
+        a->courant->utilise = 0;
+        a->taille_totale = a->pic = premier->taille;
+        return;
+    }
+
+    liberer_blocs(a->courant, NULL);
+    a->courant = unique;
+    a->taille_totale = a->pic = unique->taille;
+}
@@ -0,0 +1,45 @@
+#ifndef ARENE_H
+#define ARENE_H
+
+#include <stddef.h>
+
+/*
+ * Arène d'allocation par résolution : les allocations avancent un pointeur
+ * dans un bloc (pas d'en-tête ni de libération individuelle). Les tableaux
+ * de travail d'une itération se rendent en revenant à une marque, et toute
+ * la résolution se libère d'un coup avec vider_arene().
+ *
+ * Quand le bloc courant est plein, un nouveau bloc (au moins double) est
+ * chaîné ; vider_arene() les regroupe alors en un seul bloc de la taille
+ * totale, de sorte que les résolutions suivantes n'appellent plus malloc.
+ */
+
+typedef struct BlocArene BlocArene;
+
+typedef struct Arene {
+    BlocArene *courant;     // bloc où se font les allocations
+    size_t taille_totale;   // somme des tailles des blocs
+    size_t pic;             // plus grande valeur atteinte par taille_totale
+} Arene;
+
+// Position dans l'arène, pour rendre d'un coup tout ce qui a été alloué depuis
+typedef struct {
+    BlocArene *bloc;
+    size_t utilise;
+} MarqueArene;
+
+Arene *creer_arene(size_t taille_initiale);
+void detruire_arene(Arene *a);
+
+// Allocation alignée sur 16 octets (ou sur alignement, puissance de 2) ; NULL si mémoire épuisée
+void *arene_alloc(Arene *a, size_t taille);
+void *arene_alloc_aligne(Arene *a, size_t taille, size_t alignement);
+void *arene_calloc(Arene *a, size_t nb, size_t taille);
+
+MarqueArene arene_marque(const Arene *a);
+void arene_revenir(Arene *a, MarqueArene m);
+
+// Rend toute la mémoire de l'arène (fin d'une résolution)
+void vider_arene(Arene *a);
+
+#endif
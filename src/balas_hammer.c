@@ -1,170 +1,493 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <limits.h>
 #include "balas_hammer.h"
+#include "couts.h"
+#include "index_couts.h"
+#include "equipe.h"
+#include "tas.h"
+#include "tuiles.h"
 #include "trace.h"
+#include "annulation.h"
 
 static int minimum(int a, int b) { return (a < b) ? a : b; }
 
-// Trouve la pénalité d’une ligne
-static int penalite_ligne(const Probleme *p, int ligne) {
-    int min1 = INT_MAX, min2 = INT_MAX;
+/*
+ * Les pénalités ne portent que sur les cases encore actives. Chaque ligne
+ * et chaque colonne garde ses deux plus petits coûts actifs et leur
+ * position : rayer une colonne ne fait recalculer que les lignes dont un
+ * des deux minima tombait dans cette colonne (et inversement). La pénalité
+ * maximale se lit au sommet d'un tas indexé sur les n + m lignes/colonnes.
+ * Quand l'index des coûts triés est disponible (index_couts.h), les deux
+ * minima sont tenus par deux curseurs dans l'ordre de chaque ligne/colonne.
+ *
+ * Numérotation commune : g < n désigne la ligne F_g, g >= n la colonne C_(g-n).
+ * À pénalité égale, on retient la plus petite valeur de g (lignes d'abord,
+ * puis par indice croissant), comme un balayage lignes puis colonnes.
+ *
+ * Avec une équipe de threads, le calcul initial des minima et les réparations
+ * volumineuses sont répartis entre les membres ; chaque membre écrit des
+ * entrées distinctes, et le tas est mis à jour ensuite par le seul thread
+ * appelant, dans l'ordre des indices. L'ordre (pénalité, g) étant total, la
+ * suite des choix ne dépend pas du nombre de threads.
+ */
 
-    for (int j = 0; j < p->nb_clients; j++) {
-        int c = p->couts[ligne][j];
-        if (c < min1) { min2 = min1; min1 = c; }
-        else if (c < min2) min2 = c;
+// En dessous de ce volume de coûts à relire, une réparation reste séquentielle
+#define SEUIL_REPARATION_PARALLELE (1 << 14)
+
+// Au-delà, pas de copie transposée : les colonnes sont lues avec un pas
+#define TRANSPOSEE_OCTETS_MAX ((size_t)256 << 20)
+
+typedef struct {
+    const Probleme *p;
+    int n, m;
+    int *ligne_active;
+    int *colonne_active;
+    int nb_lignes_actives;
+    int nb_colonnes_actives;
+    DeuxMinima *minima;      // n + m entrées : lignes puis colonnes
+    int *nb_arcs_actifs;     // variante creuse : arcs autorisés actifs de chaque ligne/colonne
+    IndexCouts *index;       // coûts triés par ligne/colonne, NULL : recalcul par les noyaux
+    int *curseur1, *curseur2;  // positions des deux minima dans l'ordre de chaque ligne/colonne
+    Probleme *transposee;    // sans index : colonnes contiguës (noyaux vectoriels), ou NULL
+    int *tampon;             // ligne ou colonne recalculée (variante implicite), un par membre
+    int taille_tampon;
+    Equipe *equipe;          // NULL : thread appelant seul
+    int *a_recalculer;       // lignes/colonnes à recalculer lors d'une réparation
+    int nb_a_recalculer;
+    DeuxMinima *nouveaux;    // leurs nouveaux minima, avant mise à jour du tas
+    DeuxMinima *partiels;    // minima des colonnes par membre (calcul initial dense)
+    Tas file;                // lignes/colonnes actives par pénalité décroissante
+} EtatBH;
+
+static long long penalite(const EtatBH *e, int g)
+{
+    return e->minima[g].min2 - e->minima[g].min1;
+}
+
+// Une seule case active : pas de second minimum (sentinelle_couts). La
+// pénalité, sentinelle moins le coût de la case, place la ligne ou colonne
+// forcée avant les autres (la moins chère d'abord) ; ce n'est pas un écart
+// de coûts, elle n'est pas affichée.
+static int forcee(const EtatBH *e, int g)
+{
+    return e->minima[g].arg1 >= 0 && e->minima[g].min2 >= sentinelle_couts(e->p);
+}
+
+// La pénalité de g vient de changer : le tas range son opposé (maximum au sommet)
+static void reclasser(EtatBH *e, int g)
+{
+    if (tas_contient(&e->file, g))
+        tas_placer(&e->file, g, -penalite(e, g));
+}
+
+// Met à jour les deux plus petits coûts rencontrés
+static void retenir(DeuxMinima *d, long long c, int arg)
+{
+    if (c < d->min1) {
+        d->min2 = d->min1; d->arg2 = d->arg1;
+        d->min1 = c;       d->arg1 = arg;
+    } else if (c < d->min2) {
+        d->min2 = c;       d->arg2 = arg;
     }
-    return min2 - min1;
 }
 
-// Trouve la pénalité d’une colonne
-static int penalite_colonne(const Probleme *p, int col) {
-    int min1 = INT_MAX, min2 = INT_MAX;
+// Variante creuse : les paires absentes encore actives valent cout_interdit ;
+// deux suffisent pour les deux minima. Elles n'ont pas de position (arg = -1).
+static void retenir_interdits(const Probleme *p, int nb_interdits, DeuxMinima *d)
+{
+    for (int t = 0; t < nb_interdits && t < 2; t++)
+        retenir(d, p->cout_interdit, -1);
+}
+
+// Avance les deux curseurs de g jusqu'aux deux premières cases actives de son ordre
+static void avancer_minima(EtatBH *e, int g, DeuxMinima *d)
+{
+    const Probleme *p = e->p;
+    int ligne = (g < e->n);
+    const int *ordre = ligne ? index_ligne(e->index, g) : index_colonne(e->index, g - e->n);
+    const int *actif = ligne ? e->colonne_active : e->ligne_active;
+    int nb = ligne ? e->m : e->n;
+    int *c1 = &e->curseur1[g], *c2 = &e->curseur2[g];
+
+    *c1 = avancer_curseur(ordre, nb, *c1, actif);
+    if (*c2 <= *c1)
+        *c2 = (*c1 < nb) ? *c1 + 1 : nb;
+    *c2 = avancer_curseur(ordre, nb, *c2, actif);
 
-    for (int i = 0; i < p->nb_fournisseurs; i++) {
-        int c = p->couts[i][col];
-        if (c < min1) { min2 = min1; min1 = c; }
-        else if (c < min2) min2 = c;
+    long long sentinelle = sentinelle_couts(p);
+    d->arg1 = (*c1 < nb) ? ordre[*c1] : -1;
+    d->arg2 = (*c2 < nb) ? ordre[*c2] : -1;
+    if (ligne) {
+        d->min1 = (d->arg1 >= 0) ? cout_arc(p, g, d->arg1) : sentinelle;
+        d->min2 = (d->arg2 >= 0) ? cout_arc(p, g, d->arg2) : sentinelle;
+    } else {
+        d->min1 = (d->arg1 >= 0) ? cout_arc(p, d->arg1, g - e->n) : sentinelle;
+        d->min2 = (d->arg2 >= 0) ? cout_arc(p, d->arg2, g - e->n) : sentinelle;
     }
-    return min2 - min1;
 }
 
-void balas_hammer(const Probleme *p, Solution *s)
+// Recalcule dans *d les deux minima actifs de la ligne ou colonne g
+static void recalculer(EtatBH *e, int g, int *tampon, DeuxMinima *d)
 {
-    int provisions[p->nb_fournisseurs];
-    int commandes[p->nb_clients];
+    const Probleme *p = e->p;
 
-    for (int i = 0; i < p->nb_fournisseurs; i++)
-        provisions[i] = p->provisions[i];
+    if (e->index) {
+        avancer_minima(e, g, d);
+        return;
+    }
 
-    for (int j = 0; j < p->nb_clients; j++)
-        commandes[j] = p->commandes[j];
+    if (!est_creux(p)) {
+        if (g < e->n)
+            deux_minima_ligne(p, g, e->colonne_active, tampon, d);
+        else if (e->transposee)
+            deux_minima_ligne(e->transposee, g - e->n, e->ligne_active, tampon, d);
+        else
+            deux_minima_colonne(p, g - e->n, e->ligne_active, tampon, d);
+        return;
+    }
 
-    int ligne_active[p->nb_fournisseurs];
-    int colonne_active[p->nb_clients];
+    d->min1 = d->min2 = sentinelle_couts(p);
+    d->arg1 = d->arg2 = -1;
+    if (g < e->n) {
+        for (int k = p->debut_ligne[g]; k < p->debut_ligne[g + 1]; k++) {
+            int j = p->arc_client[k];
+            if (e->colonne_active[j])
+                retenir(d, p->arc_cout[k], j);
+        }
+        retenir_interdits(p, e->nb_colonnes_actives - e->nb_arcs_actifs[g], d);
+    } else {
+        int j = g - e->n;
+        for (int k = p->debut_colonne[j]; k < p->debut_colonne[j + 1]; k++) {
+            int i = p->fournisseur_par_colonne[k];
+            if (e->ligne_active[i])
+                retenir(d, p->arc_cout[p->arc_par_colonne[k]], i);
+        }
+        retenir_interdits(p, e->nb_lignes_actives - e->nb_arcs_actifs[g], d);
+    }
+}
 
-    for (int i = 0; i < p->nb_fournisseurs; i++)
-        ligne_active[i] = 1;
+// Tâche d'équipe : recalcule a_recalculer[k] dans nouveaux[k], par parts
+static void recalculer_part(void *ctx, int rang, int nb_membres)
+{
+    EtatBH *e = ctx;
+    int *tampon = e->tampon + (size_t)rang * e->taille_tampon;
+    int debut, fin;
 
-    for (int j = 0; j < p->nb_clients; j++)
-        colonne_active[j] = 1;
+    part_equipe(e->nb_a_recalculer, rang, nb_membres, &debut, &fin);
+    for (int k = debut; k < fin; k++)
+        recalculer(e, e->a_recalculer[k], tampon, &e->nouveaux[k]);
+}
 
-    trace("\n--- Déroulé de la méthode de Balas-Hammer ---\n\n");
+// Tâche d'équipe (matrice dense ou implicite) : minima d'un bloc de lignes,
+// et minima partiels des colonnes sur ce bloc
+static void minima_initiaux_part(void *ctx, int rang, int nb_membres)
+{
+    EtatBH *e = ctx;
+    const Probleme *p = e->p;
+    int *tampon = e->tampon + (size_t)rang * e->taille_tampon;
+    DeuxMinima *colonnes = (rang == 0) ? e->minima + e->n : e->partiels + (size_t)(rang - 1) * e->m;
+    int debut, fin;
 
-    while (1)
-    {
-        /* Nombre de lignes/colonnes encore vraiment utilisables (quantités > 0) */
-        int nb_lignes_actives = 0;
-        int nb_colonnes_actives = 0;
-
-        for (int i = 0; i < p->nb_fournisseurs; i++) {
-            if (ligne_active[i] && provisions[i] > 0)
-                nb_lignes_actives++;
-            else if (provisions[i] == 0)
-                ligne_active[i] = 0; /* nettoyage au passage */
+    part_equipe(e->n, rang, nb_membres, &debut, &fin);
+    debut_minima_colonnes(p, colonnes);
+    for (int i = debut; i < fin; i++) {
+        if (nb_membres == 1)
+            entrer_tuile(p, i);
+        if (e->ligne_active[i])
+            accumuler_minima_colonnes(p, i, tampon, colonnes);
+        deux_minima_ligne(p, i, e->colonne_active, tampon, &e->minima[i]);
+    }
+}
+
+static void initialiser_minima(EtatBH *e)
+{
+    const Probleme *p = e->p;
+
+    if (e->index || est_creux(p)) {
+        if (e->index) {
+            for (int g = 0; g < e->n + e->m; g++)
+                e->curseur1[g] = e->curseur2[g] = 0;
+        } else {
+            for (int i = 0; i < e->n; i++)
+                e->nb_arcs_actifs[i] = p->debut_ligne[i + 1] - p->debut_ligne[i];
+            for (int j = 0; j < e->m; j++)
+                e->nb_arcs_actifs[e->n + j] = p->debut_colonne[j + 1] - p->debut_colonne[j];
         }
-        for (int j = 0; j < p->nb_clients; j++) {
-            if (colonne_active[j] && commandes[j] > 0)
-                nb_colonnes_actives++;
-            else if (commandes[j] == 0)
-                colonne_active[j] = 0;
+        e->nb_a_recalculer = e->n + e->m;
+        for (int g = 0; g < e->n + e->m; g++)
+            e->a_recalculer[g] = g;
+        executer_equipe(e->equipe, recalculer_part, e);
+        for (int g = 0; g < e->n + e->m; g++)
+            e->minima[g] = e->nouveaux[g];
+        return;
+    }
+
+    // Un parcours ligne par ligne donne les minima des lignes et ceux des
+    // colonnes. Seul, il suit les tuiles ; en équipe, chaque membre traite
+    // un bloc de lignes, puis les minima partiels des colonnes sont fusionnés
+    // dans l'ordre des blocs (à égalité, la première ligne l'emporte).
+    // Une matrice projetée lue par tuiles se parcourt seul, dans l'ordre.
+    Equipe *equipe = (p->tuilage && p->projection) ? NULL : e->equipe;
+    executer_equipe(equipe, minima_initiaux_part, e);
+
+    int nb_membres = taille_equipe(equipe);
+    if (nb_membres > 1)
+        compter_lignes_lues(p, e->n);
+    for (int r = 1; r < nb_membres; r++) {
+        const DeuxMinima *partiel = e->partiels + (size_t)(r - 1) * e->m;
+        for (int j = 0; j < e->m; j++) {
+            DeuxMinima *d = &e->minima[e->n + j];
+            retenir(d, partiel[j].min1, partiel[j].arg1);
+            retenir(d, partiel[j].min2, partiel[j].arg2);
         }
+    }
+}
 
-        if (nb_lignes_actives + nb_colonnes_actives <= 1)
-            break;
-
-        int meilleure_penalite = -1;
-        int type = 0;   // 0 = ligne, 1 = colonne
-        int indice = -1;
-
-        // Pénalités lignes
-        for (int i = 0; i < p->nb_fournisseurs; i++) {
-            if (!ligne_active[i] || provisions[i] == 0) continue;
-            int pen_ligne = penalite_ligne(p, i);
-            if (pen_ligne > meilleure_penalite) {
-                meilleure_penalite = pen_ligne;
-                type = 0;
-                indice = i;
-            }
+// Raye la ligne (g < n) ou la colonne g, puis répare les lignes de l'autre
+// dimension dont un des deux minima s'appuyait sur elle
+static void rayer(EtatBH *e, int g)
+{
+    const Probleme *p = e->p;
+    int creux = est_creux(p);
+    int debut, fin;     // lignes/colonnes de l'autre dimension, en numérotation commune
+
+    tas_retirer(&e->file, g);
+    if (g < e->n) {
+        e->ligne_active[g] = 0;
+        e->nb_lignes_actives--;
+        debut = e->n;
+        fin = e->n + e->m;
+        if (creux)
+            for (int k = p->debut_ligne[g]; k < p->debut_ligne[g + 1]; k++)
+                e->nb_arcs_actifs[e->n + p->arc_client[k]]--;
+    } else {
+        e->colonne_active[g - e->n] = 0;
+        e->nb_colonnes_actives--;
+        debut = 0;
+        fin = e->n;
+        if (creux) {
+            int j = g - e->n;
+            for (int k = p->debut_colonne[j]; k < p->debut_colonne[j + 1]; k++)
+                e->nb_arcs_actifs[p->fournisseur_par_colonne[k]]--;
         }
+    }
+
+    int indice = (g < e->n) ? g : g - e->n;
+    int nb_actifs = (g < e->n) ? e->nb_lignes_actives : e->nb_colonnes_actives;
+
+    e->nb_a_recalculer = 0;
+    for (int h = debut; h < fin; h++) {
+        if (!tas_contient(&e->file, h))
+            continue;
 
-        // Pénalités colonnes
-        for (int j = 0; j < p->nb_clients; j++) {
-            if (!colonne_active[j] || commandes[j] == 0) continue;
-            int pen_colonne = penalite_colonne(p, j);
-            if (pen_colonne > meilleure_penalite) {
-                meilleure_penalite = pen_colonne;
-                type = 1;
-                indice = j;
+        const DeuxMinima *d = &e->minima[h];
+        int touche = (d->arg1 == indice || d->arg2 == indice);
+        // Variante creuse : moins de deux paires interdites actives changent les minima
+        if (creux && !touche)
+            touche = (nb_actifs - e->nb_arcs_actifs[h] < 2);
+
+        if (touche)
+            e->a_recalculer[e->nb_a_recalculer++] = h;
+    }
+
+    // Les curseurs de l'index avancent en O(1) amorti : rien à répartir.
+    // Sinon, chaque recalcul relit une ligne de l'autre dimension.
+    long long volume = e->index ? 0 : (long long)e->nb_a_recalculer * (fin == e->n ? e->m : e->n);
+    if (volume >= SEUIL_REPARATION_PARALLELE)
+        executer_equipe(e->equipe, recalculer_part, e);
+    else
+        recalculer_part(e, 0, 1);
+
+    // Mise à jour du tas une entrée à la fois, dans l'ordre des indices
+    for (int k = 0; k < e->nb_a_recalculer; k++) {
+        int h = e->a_recalculer[k];
+        e->minima[h] = e->nouveaux[k];
+        reclasser(e, h);
+    }
+}
+
+// Variante creuse : case la moins chère parmi les arcs autorisés encore actifs
+// de la ligne (type 0) ou de la colonne (type 1). À défaut, on prend la
+// première case active, qui est alors un arc artificiel.
+static long long case_min_creuse(const Probleme *p, int type, int indice,
+                                 const int ligne_active[], const int colonne_active[],
+                                 int *meilleur_i, int *meilleur_j)
+{
+    long long meilleur_cout = LLONG_MAX;
+
+    if (type == 0) {
+        for (int k = p->debut_ligne[indice]; k < p->debut_ligne[indice + 1]; k++) {
+            int j = p->arc_client[k];
+            if (!colonne_active[j]) continue;
+            if (p->arc_cout[k] < meilleur_cout) {
+                meilleur_cout = p->arc_cout[k];
+                *meilleur_i = indice;
+                *meilleur_j = j;
+            }
+        }
+        for (int j = 0; j < p->nb_clients && meilleur_cout == LLONG_MAX; j++) {
+            if (!colonne_active[j]) continue;
+            meilleur_cout = p->cout_interdit;
+            *meilleur_i = indice;
+            *meilleur_j = j;
+        }
+    } else {
+        for (int k = p->debut_colonne[indice]; k < p->debut_colonne[indice + 1]; k++) {
+            int i = p->fournisseur_par_colonne[k];
+            long long c = p->arc_cout[p->arc_par_colonne[k]];
+            if (!ligne_active[i]) continue;
+            if (c < meilleur_cout) {
+                meilleur_cout = c;
+                *meilleur_i = i;
+                *meilleur_j = indice;
             }
         }
+        for (int i = 0; i < p->nb_fournisseurs && meilleur_cout == LLONG_MAX; i++) {
+            if (!ligne_active[i]) continue;
+            meilleur_cout = p->cout_interdit;
+            *meilleur_i = i;
+            *meilleur_j = indice;
+        }
+    }
+
+    return meilleur_cout;
+}
+
+void balas_hammer(const Probleme *p, Solution *s)
+{
+    balas_hammer_parallele(p, s, 1);
+}
+
+void balas_hammer_parallele(const Probleme *p, Solution *s, int nb_threads)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    int provisions[n];
+    int commandes[m];
+
+    for (int i = 0; i < n; i++)
+        provisions[i] = p->provisions[i];
 
-        trace("Pénalité maximale : %d → %s %d\n",
-               meilleure_penalite,
-               type == 0 ? "ligne" : "colonne",
-               indice);
+    for (int j = 0; j < m; j++)
+        commandes[j] = p->commandes[j];
+
+    EtatBH e = { .p = p, .n = n, .m = m };
+    e.equipe = (nb_threads == 1) ? NULL : creer_equipe(nb_threads);
+    int nb_membres = taille_equipe(e.equipe);
+
+    e.taille_tampon   = taille_tampon_couts(p);
+    e.ligne_active    = malloc((size_t)n * sizeof(int));
+    e.colonne_active  = malloc((size_t)m * sizeof(int));
+    e.minima          = malloc((size_t)(n + m) * sizeof(DeuxMinima));
+    e.nb_arcs_actifs  = malloc((size_t)(n + m) * sizeof(int));
+    e.tampon          = malloc((size_t)nb_membres * e.taille_tampon * sizeof(int));
+    e.curseur1        = malloc((size_t)(n + m) * sizeof(int));
+    e.curseur2        = malloc((size_t)(n + m) * sizeof(int));
+    e.a_recalculer    = malloc((size_t)(n + m) * sizeof(int));
+    e.nouveaux        = malloc((size_t)(n + m) * sizeof(DeuxMinima));
+    e.partiels        = malloc(((size_t)(nb_membres - 1) * m + 1) * sizeof(DeuxMinima));
+
+    if (!e.ligne_active || !e.colonne_active || !e.minima || !e.nb_arcs_actifs ||
+        !e.tampon || !e.curseur1 || !e.curseur2 ||
+        !e.a_recalculer || !e.nouveaux || !e.partiels || initialiser_tas(&e.file, n + m) != 0) {
+        trace("Erreur BH : mémoire insuffisante.\n");
+        goto fin;
+    }
+
+    trace("\n--- Déroulé de la méthode de Balas-Hammer ---\n\n");
+
+    // Une ligne ou colonne sans quantité est rayée d'emblée
+    for (int i = 0; i < n; i++) {
+        e.ligne_active[i] = (provisions[i] > 0);
+        e.nb_lignes_actives += e.ligne_active[i];
+    }
+    for (int j = 0; j < m; j++) {
+        e.colonne_active[j] = (commandes[j] > 0);
+        e.nb_colonnes_actives += e.colonne_active[j];
+    }
+
+    // Tri préalable des coûts (matrices denses ou implicites, dans la limite
+    // du budget mémoire) ; à défaut, les minima sont recalculés par balayage
+    e.index = construire_index_couts(p, e.equipe);
+    if (!e.index && p->couts && !(p->tuilage && p->projection) &&
+        (size_t)n * m * p->largeur_couts <= TRANSPOSEE_OCTETS_MAX)
+        e.transposee = transposer_probleme(p);
+    initialiser_minima(&e);
+
+    for (int g = 0; g < n + m; g++) {
+        int actif = (g < n) ? e.ligne_active[g] : e.colonne_active[g - n];
+        if (actif)
+            tas_placer(&e.file, g, -penalite(&e, g));
+    }
+
+    while (e.nb_lignes_actives + e.nb_colonnes_actives > 1 && !methode_annulee())
+    {
+        int g = tas_sommet(&e.file);
+        long long meilleure_penalite = penalite(&e, g);
+        int type = (g < n) ? 0 : 1;   // 0 = ligne, 1 = colonne
+        int indice = (g < n) ? g : g - n;
+
+        if (forcee(&e, g))
+            trace("Pénalité maximale : forcée (une seule case active) → %s %d\n",
+                  type == 0 ? "ligne" : "colonne", indice);
+        else
+            trace("Pénalité maximale : %lld → %s %d\n",
+                  meilleure_penalite,
+                  type == 0 ? "ligne" : "colonne",
+                  indice);
 
         int meilleur_i = -1;
         int meilleur_j = -1;
-        int meilleur_cout = INT_MAX;
-
-        if (type == 0) {
-            for (int j = 0; j < p->nb_clients; j++) {
-                if (!colonne_active[j] || commandes[j] == 0) continue;
-                if (p->couts[indice][j] < meilleur_cout) {
-                    meilleur_cout = p->couts[indice][j];
-                    meilleur_i = indice;
-                    meilleur_j = j;
-                }
-            }
-        } else {
-            for (int i = 0; i < p->nb_fournisseurs; i++) {
-                if (!ligne_active[i] || provisions[i] == 0) continue;
-                if (p->couts[i][indice] < meilleur_cout) {
-                    meilleur_cout = p->couts[i][indice];
-                    meilleur_i = i;
-                    meilleur_j = indice;
-                }
-            }
+        long long meilleur_cout = INT_MAX;
+
+        if (est_creux(p)) {
+            meilleur_cout = case_min_creuse(p, type, indice,
+                                            e.ligne_active, e.colonne_active,
+                                            &meilleur_i, &meilleur_j);
+        } else if (e.minima[g].arg1 >= 0) {
+            // Case la moins chère : premier minimum actif de la ligne/colonne
+            meilleur_cout = e.minima[g].min1;
+            meilleur_i = (type == 0) ? indice : e.minima[g].arg1;
+            meilleur_j = (type == 0) ? e.minima[g].arg1 : indice;
         }
         if (meilleur_i == -1 || meilleur_j == -1) {
             trace("Erreur BH : aucune cellule valide trouvée (base complète ? données incohérentes ?)\n");
             break;   // ou return ;
         }
-        
 
         int q = minimum(provisions[meilleur_i], commandes[meilleur_j]);
-        s->x[meilleur_i][meilleur_j] = q;
+        sol_fixer(s, meilleur_i, meilleur_j, q);
 
-        trace("Remplissage de la case (%d,%d) avec %d unités (coût %d)\n",
+        trace("Remplissage de la case (%d,%d) avec %d unités (coût %lld)\n",
                meilleur_i, meilleur_j, q, meilleur_cout);
 
         provisions[meilleur_i] -= q;
         commandes[meilleur_j]  -= q;
 
-        /* Éviter de rayer simultanément la ligne ET la colonne en cas d’égalité */
-        if (provisions[meilleur_i] == 0 && commandes[meilleur_j] == 0) {
-            int pen_ligne = penalite_ligne(p, meilleur_i);
-            int pen_col  = penalite_colonne(p, meilleur_j);
-
-            if (pen_ligne > pen_col) {
-                colonne_active[meilleur_j] = 0;
-            } else if (pen_col > pen_ligne) {
-                ligne_active[meilleur_i] = 0;
-            } else {
-                /* À égalité parfaite, on garde la dimension qui offre le plus d’options restantes */
-                if (nb_lignes_actives >= nb_colonnes_actives)
-                    colonne_active[meilleur_j] = 0;
-                else
-                    ligne_active[meilleur_i] = 0;
-            }
-        } else {
-            if (provisions[meilleur_i] == 0)
-                ligne_active[meilleur_i] = 0;
-            if (commandes[meilleur_j] == 0)
-                colonne_active[meilleur_j] = 0;
-        }
+        // Une quantité épuisée raye sa ligne ou sa colonne (les deux à égalité)
+        if (provisions[meilleur_i] == 0)
+            rayer(&e, meilleur_i);
+        if (commandes[meilleur_j] == 0)
+            rayer(&e, n + meilleur_j);
     }
 
     trace("\n--- Fin de la méthode de Balas-Hammer ---\n\n");
+
+fin:
+    free(e.ligne_active);
+    free(e.colonne_active);
+    free(e.minima);
+    free(e.nb_arcs_actifs);
+    free(e.tampon);
+    liberer_tas(&e.file);
+    free(e.curseur1);
+    free(e.curseur2);
+    free(e.a_recalculer);
+    free(e.nouveaux);
+    free(e.partiels);
+    liberer_index_couts(e.index);
+    if (e.transposee)
+        liberer_probleme(e.transposee);
+    detruire_equipe(e.equipe);
 }
@@ -6,4 +6,8 @@
 // Calcule la proposition initiale via la méthode de Balas-Hammer
 void balas_hammer(const Probleme *p, Solution *s);
 
+// Idem en répartissant l'évaluation des pénalités entre nb_threads threads
+// (0 : un par cœur). Le résultat et les traces ne dépendent pas de nb_threads.
+void balas_hammer_parallele(const Probleme *p, Solution *s, int nb_threads);
+
 #endif
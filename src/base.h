@@ -7,11 +7,51 @@
 typedef struct {
     int nb_arcs;      // nombre d'arcs de la base
     int (*arcs)[2];   // arcs[k][0] = i (fournisseur), arcs[k][1] = j (client)
+    int nb_clients;
+    int *index;       // table de hachage (i,j) -> k, adressage ouvert, -1 si libre
+                      // (NULL : simple vue sur des arcs, recherche linéaire)
+    int taille_index; // puissance de 2, au moins le double de la capacité
+    struct Arene *arene;  // arène propriétaire, NULL : malloc
 } Base;
 
 // Construit la base à partir de la solution (on garde les x[i][j] > 0)
 Base *construire_base(const Solution *s);
 
+// Mêmes opérations, avec une base (et ses tableaux de travail) pris dans l'arène a
+Base *construire_base_dans(const Solution *s, struct Arene *a);
+Base *corriger_base_dans(const Base *b, Solution *s, int nb_fournisseur, int nb_clients,
+                         struct Arene *a);
+
+// Indice k de l'arc (i, j) dans b->arcs, -1 s'il n'est pas dans la base
+// (O(1) en moyenne par l'index)
+int base_chercher_arc(const Base *b, int i, int j);
+
+static inline int arc_dans_base(const Base *b, int i, int j)
+{
+    return base_chercher_arc(b, i, j) >= 0;
+}
+
+// L'arc k devient (i, j), index compris (pivot : l'arc entrant prend la
+// place de l'arc sortant)
+void base_remplacer_arc(Base *b, int k, int i, int j);
+
+// Adjacence de la base (format CSR), construite une fois par base : les
+// voisins du sommet u sont voisins[debut[u] .. debut[u + 1]), dans l'ordre
+// des arcs de la base. Sommets : fournisseurs 0..n-1, clients n..n+m-1.
+typedef struct {
+    int nb_sommets;
+    int nb_fournisseurs;
+    int *debut;       // nb_sommets + 1
+    int *voisins;     // 2 x nb_arcs
+    int *arc;         // 2 x nb_arcs : indice dans la base de l'arc vers voisins[k]
+    struct Arene *arene;  // arène propriétaire, NULL : malloc
+} AdjacenceBase;
+
+AdjacenceBase *construire_adjacence(const Base *b, int nb_fournisseurs, int nb_clients);
+AdjacenceBase *construire_adjacence_dans(const Base *b, int nb_fournisseurs, int nb_clients,
+                                         struct Arene *a);
+void liberer_adjacence(AdjacenceBase *adj);
+
 // Affichage simple : liste des arcs F_i -> C_j
 void afficher_base_liste(const Base *b);
 
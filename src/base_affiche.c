@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <limits.h>
 #include "base.h"
+#include "arbre_base.h"
+#include "arene.h"
 #include "trace.h"
 
 #define LARGEUR_ASCII 200
@@ -24,47 +26,235 @@ static void dessiner_texte(char canvas[HAUTEUR_ASCII][LARGEUR_ASCII],
 
 // ---------- Construction de la base ----------
 
-Base *construire_base(const Solution *s)
+// Base vide pouvant recevoir capacite arcs, index compris
+static Base *nouvelle_base(Arene *a, int capacite, int nb_clients)
 {
-    Base *b = malloc(sizeof(Base));
+    Base *b = a ? arene_alloc(a, sizeof(Base)) : malloc(sizeof(Base));
     if (!b) return NULL;
 
-    int compteur = 0;
-    for (int i = 0; i < s->nb_fournisseurs; i++) {
-        for (int j = 0; j < s->nb_clients; j++) {
-            if (s->x[i][j] > 0)
-                compteur++;
-        }
+    b->nb_arcs = 0;
+    b->nb_clients = nb_clients;
+    b->arene = a;
+    b->arcs = NULL;
+    b->taille_index = 4;
+    while (b->taille_index < 2 * capacite)
+        b->taille_index *= 2;
+
+    size_t taille = sizeof(int[2]) * (size_t)(capacite > 0 ? capacite : 1);
+    size_t taille_index = sizeof(int) * (size_t)b->taille_index;
+    if (a) {
+        b->arcs = arene_alloc(a, taille);
+        b->index = arene_alloc(a, taille_index);
+    } else {
+        b->arcs = malloc(taille);
+        b->index = malloc(taille_index);
+    }
+    if (!b->arcs || !b->index) {
+        liberer_base(b);
+        return NULL;
     }
+    for (int h = 0; h < b->taille_index; h++)
+        b->index[h] = -1;
+    return b;
+}
 
-    b->nb_arcs = compteur;
-    b->arcs = NULL;
+// ---------- Index (i,j) -> k, comme celui de la solution ----------
+
+static unsigned hacher_arc(const Base *b, int i, int j)
+{
+    unsigned long long cle = (unsigned long long)i * (unsigned)b->nb_clients + (unsigned)j;
+    return (unsigned)((cle * 0x9E3779B97F4A7C15ull) >> 32) & (unsigned)(b->taille_index - 1);
+}
+
+// Position dans l'index de l'arc (i,j), ou de l'emplacement libre où l'insérer
+static unsigned chercher_place(const Base *b, int i, int j)
+{
+    unsigned h = hacher_arc(b, i, j);
+    while (b->index[h] != -1) {
+        int k = b->index[h];
+        if (b->arcs[k][0] == i && b->arcs[k][1] == j)
+            break;
+        h = (h + 1) & (unsigned)(b->taille_index - 1);
+    }
+    return h;
+}
+
+int base_chercher_arc(const Base *b, int i, int j)
+{
+    if (!b) return -1;
+    if (!b->index) {
+        for (int k = 0; k < b->nb_arcs; k++)
+            if (b->arcs[k][0] == i && b->arcs[k][1] == j)
+                return k;
+        return -1;
+    }
+    return b->index[chercher_place(b, i, j)];
+}
+
+// Ajoute (i,j) en fin de base (capacité suffisante, arc absent)
+static void ajouter_arc(Base *b, int i, int j)
+{
+    int k = b->nb_arcs++;
+    b->arcs[k][0] = i;
+    b->arcs[k][1] = j;
+    b->index[chercher_place(b, i, j)] = k;
+}
+
+void base_remplacer_arc(Base *b, int k, int i, int j)
+{
+    if (!b->index) {
+        b->arcs[k][0] = i;
+        b->arcs[k][1] = j;
+        return;
+    }
+
+    // Retrait de l'ancien arc (sondage linéaire : on recompacte la suite)
+    unsigned masque = (unsigned)(b->taille_index - 1);
+    unsigned h = chercher_place(b, b->arcs[k][0], b->arcs[k][1]);
+    b->index[h] = -1;
+    for (unsigned t = (h + 1) & masque; b->index[t] != -1; t = (t + 1) & masque) {
+        int r = b->index[t];
+        b->index[t] = -1;
+        b->index[chercher_place(b, b->arcs[r][0], b->arcs[r][1])] = r;
+    }
+
+    b->arcs[k][0] = i;
+    b->arcs[k][1] = j;
+    b->index[chercher_place(b, i, j)] = k;
+}
+
+Base *construire_base_dans(const Solution *s, Arene *a)
+{
+    int compteur = 0;
+    for (int k = 0; k < s->nb_cases; k++)
+        if (s->flux[k] > 0)
+            compteur++;
+
+    int n = s->nb_fournisseurs;
+    int m = s->nb_clients;
+    Base *b = nouvelle_base(a, compteur, m);
+    if (!b) return NULL;
 
     if (compteur == 0) {
         // Base vide (cas théorique)
         return b;
     }
 
-    b->arcs = malloc(sizeof(int[2]) * compteur);
-    if (!b->arcs) {
-        free(b);
+    size_t taille_debut = sizeof(int) * (size_t)((n > m ? n : m) + 1);
+    MarqueArene marque = { NULL, 0 };
+    int *par_client, *debut;
+    if (a) {
+        marque = arene_marque(a);
+        par_client = arene_alloc(a, sizeof(int) * compteur);
+        debut = arene_alloc(a, taille_debut);
+    } else {
+        par_client = malloc(sizeof(int) * compteur);
+        debut = malloc(taille_debut);
+    }
+    if (!par_client || !debut) {
+        if (a) {
+            arene_revenir(a, marque);
+        } else {
+            free(debut);
+            free(par_client);
+        }
+        liberer_base(b);
         return NULL;
     }
 
-    int k = 0;
-    for (int i = 0; i < s->nb_fournisseurs; i++) {
-        for (int j = 0; j < s->nb_clients; j++) {
-            if (s->x[i][j] > 0) {
-                b->arcs[k][0] = i;   // fournisseur
-                b->arcs[k][1] = j;   // client
-                k++;
-            }
-        }
+    // Deux tris par dénombrement (client, puis fournisseur, stable) : les arcs
+    // sortent dans l'ordre d'un parcours ligne par ligne du tableau, en
+    // O(n + m + nb_cases) sans jamais balayer les n x m cases.
+    for (int j = 0; j <= m; j++) debut[j] = 0;
+    for (int k = 0; k < s->nb_cases; k++)
+        if (s->flux[k] > 0)
+            debut[s->case_j[k] + 1]++;
+    for (int j = 0; j < m; j++) debut[j + 1] += debut[j];
+    for (int k = 0; k < s->nb_cases; k++)
+        if (s->flux[k] > 0)
+            par_client[debut[s->case_j[k]]++] = k;
+
+    for (int i = 0; i <= n; i++) debut[i] = 0;
+    for (int t = 0; t < compteur; t++)
+        debut[s->case_i[par_client[t]] + 1]++;
+    for (int i = 0; i < n; i++) debut[i + 1] += debut[i];
+    for (int t = 0; t < compteur; t++) {
+        int k = par_client[t];
+        int pos = debut[s->case_i[k]]++;
+        b->arcs[pos][0] = s->case_i[k];   // fournisseur
+        b->arcs[pos][1] = s->case_j[k];   // client
     }
+    b->nb_arcs = compteur;
+    for (int k = 0; k < compteur; k++)
+        b->index[chercher_place(b, b->arcs[k][0], b->arcs[k][1])] = k;
 
+    if (a) {
+        arene_revenir(a, marque);
+    } else {
+        free(debut);
+        free(par_client);
+    }
     return b;
 }
 
+Base *construire_base(const Solution *s)
+{
+    return construire_base_dans(s, NULL);
+}
+
+// ---------- Adjacence (CSR) ----------
+
+AdjacenceBase *construire_adjacence_dans(const Base *b, int n, int m, Arene *a)
+{
+    int total = n + m;
+    size_t taille_voisins = sizeof(int) * (size_t)(2 * b->nb_arcs + 1);
+    AdjacenceBase *adj = a ? arene_alloc(a, sizeof(AdjacenceBase)) : malloc(sizeof(AdjacenceBase));
+    if (!adj) return NULL;
+
+    adj->nb_sommets = total;
+    adj->nb_fournisseurs = n;
+    adj->arene = a;
+    if (a) {
+        adj->debut = arene_alloc(a, sizeof(int) * (size_t)(total + 1));
+        adj->voisins = arene_alloc(a, taille_voisins);
+        adj->arc = arene_alloc(a, taille_voisins);
+    } else {
+        adj->debut = malloc(sizeof(int) * (size_t)(total + 1));
+        adj->voisins = malloc(taille_voisins);
+        adj->arc = malloc(taille_voisins);
+    }
+    if (!adj->debut || !adj->voisins || !adj->arc) {
+        liberer_adjacence(adj);
+        return NULL;
+    }
+
+    // Dénombrement des degrés, préfixes, puis répartition dans l'ordre des arcs
+    for (int u = 0; u <= total; u++) adj->debut[u] = 0;
+    for (int k = 0; k < b->nb_arcs; k++) {
+        adj->debut[b->arcs[k][0] + 1]++;
+        adj->debut[n + b->arcs[k][1] + 1]++;
+    }
+    for (int u = 0; u < total; u++) adj->debut[u + 1] += adj->debut[u];
+    for (int k = 0; k < b->nb_arcs; k++) {
+        int f = b->arcs[k][0];
+        int c = n + b->arcs[k][1];
+        adj->arc[adj->debut[f]] = k;
+        adj->voisins[adj->debut[f]++] = c;
+        adj->arc[adj->debut[c]] = k;
+        adj->voisins[adj->debut[c]++] = f;
+    }
+    // Chaque début a avancé jusqu'à la fin de son sommet : on le décale
+    for (int u = total; u > 0; u--) adj->debut[u] = adj->debut[u - 1];
+    adj->debut[0] = 0;
+
+    return adj;
+}
+
+AdjacenceBase *construire_adjacence(const Base *b, int n, int m)
+{
+    return construire_adjacence_dans(b, n, m, NULL);
+}
+
 // ---------- Affichage simple (liste d'arcs) ----------
 
 void afficher_base_liste(const Base *b)
@@ -239,80 +429,6 @@ int base_est_arbre(const Base *b, int n, int m)
 // du cycle, on pousse un flux theta = min sur les arcs "−".
 // Au moins un arc tombe à 0 → on récupère une base arborescente.
 
-// Retourne 1 si un cycle a été trouvé et remplit cycle_noeuds (avec nœud initial répété à la fin)
-static int dfs_cycle(const Base *b, int n, int m, int u, int parent_node,
-                     int visited[], int parent[],
-                     int cycle_noeuds[], int *cycle_len)
-{
-    int total_nodes = n + m;
-    visited[u] = 1;
-
-    for (int k = 0; k < b->nb_arcs; k++) {
-        int fi = b->arcs[k][0];
-        int cj = b->arcs[k][1];
-        int v = -1;
-        if (u == fi) v = n + cj;
-        else if (u == n + cj) v = fi;
-        else continue;
-
-        if (!visited[v]) {
-            parent[v] = u;
-            if (dfs_cycle(b, n, m, v, u, visited, parent, cycle_noeuds, cycle_len))
-                return 1;
-        } else if (v != parent_node) {
-            // Cycle trouvé (arête de retour u - v)
-            int temp[total_nodes];
-            int len = 0;
-            int cur = u;
-            temp[len++] = u;
-            while (cur != v && cur != -1) {
-                cur = parent[cur];
-                temp[len++] = cur;
-            }
-            if (cur == -1) continue; // sécurité
-
-            int idx = 0;
-            cycle_noeuds[idx++] = v;
-            for (int t = 0; t < len; t++)
-                cycle_noeuds[idx++] = temp[t];
-            cycle_noeuds[idx++] = v; // refermer
-
-            *cycle_len = idx;
-            return 1;
-        }
-    }
-    return 0;
-}
-
-static int trouver_cycle(const Base *b, int n, int m, int cycle_noeuds[], int *cycle_len)
-{
-    int total = n + m;
-    int visited[total];
-    int parent[total];
-
-    for (int i = 0; i < total; i++) {
-        visited[i] = 0;
-        parent[i] = -1;
-    }
-
-    for (int start = 0; start < total; start++) {
-        if (!visited[start]) {
-            if (dfs_cycle(b, n, m, start, -1, visited, parent, cycle_noeuds, cycle_len))
-                return 1;
-        }
-    }
-    return 0;
-}
-
-static int arc_existe(const Base *b, int nb_arcs_utilises, int fi, int cj)
-{
-    for (int k = 0; k < nb_arcs_utilises; k++) {
-        if (b->arcs[k][0] == fi && b->arcs[k][1] == cj)
-            return 1;
-    }
-    return 0;
-}
-
 static int find_parent(int x, int parent_conn[])
 {
     if (parent_conn[x] != x)
@@ -327,15 +443,57 @@ static void unite_parent(int a, int b, int parent_conn[])
     if (ra != rb) parent_conn[rb] = ra;
 }
 
-Base *corriger_base(const Base *b, Solution *s, int n, int m)
+// Retourne 1 si un cycle a été trouvé et remplit cycle_noeuds (avec nœud initial répété à la fin).
+// Le premier arc qui relie deux sommets déjà connectés (union-find, dans
+// l'ordre des arcs) ferme un cycle : on enracine les arcs précédents en
+// l'une de ses extrémités, et le cycle remonte de l'autre jusqu'à la racine.
+static int trouver_cycle(const Base *b, int n, int m, int cycle_noeuds[], int *cycle_len)
+{
+    int total = n + m;
+    int parent_conn[total];
+    for (int i = 0; i < total; i++) parent_conn[i] = i;
+
+    int k_cycle = -1;
+    for (int k = 0; k < b->nb_arcs && k_cycle < 0; k++) {
+        int fi = b->arcs[k][0];
+        int cj = b->arcs[k][1];
+        if (find_parent(fi, parent_conn) == find_parent(n + cj, parent_conn))
+            k_cycle = k;
+        else
+            unite_parent(fi, n + cj, parent_conn);
+    }
+    if (k_cycle < 0) return 0;
+
+    Base avant = { .nb_arcs = k_cycle, .arcs = b->arcs };  // vue sans index
+    AdjacenceBase *adj = construire_adjacence(&avant, n, m);
+    ArbreBase *t = creer_arbre_base(n, m, NULL);
+    int trouve = 0;
+    if (adj && t) {
+        int u = b->arcs[k_cycle][0];
+        int v = n + b->arcs[k_cycle][1];
+        enraciner_arbre(t, adj, u);
+
+        int len = 0;
+        for (int x = v; x != -1; x = t->pere[x])
+            cycle_noeuds[len++] = x;
+        cycle_noeuds[len++] = v; // refermer par l'arc (u, v)
+        *cycle_len = len;
+        trouve = 1;
+    }
+    liberer_adjacence(adj);
+    liberer_arbre_base(t);
+    return trouve;
+}
+
+Base *corriger_base_dans(const Base *b, Solution *s, int n, int m, Arene *a)
 {
     int total = n + m;
     int max_cycle = total + 2; // borne haute pour stocker le cycle (noeud répété)
 
-    if (!b) return construire_base(s);
+    if (!b) return construire_base_dans(s, a);
 
     // Pas de correction si déjà un arbre
-    if (base_est_arbre(b, n, m)) return construire_base(s);
+    if (base_est_arbre(b, n, m)) return construire_base_dans(s, a);
 
     // Cas 1 : base non connexe / trop peu d'arcs. On ajoute des arcs de valeur 0 pour obtenir n+m-1 arcs.
     if (b->nb_arcs < n + m - 1) {
@@ -351,16 +509,12 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
             deg[n + cj]++;
         }
 
-        Base *nb = malloc(sizeof(Base));
-        nb->arcs = malloc(sizeof(int[2]) * (n + m - 1));
-        nb->nb_arcs = 0;
+        Base *nb = nouvelle_base(a, n + m - 1, m);
+        if (!nb) return NULL;
 
         // Copier les arcs existants
-        for (int k = 0; k < b->nb_arcs; k++) {
-            nb->arcs[nb->nb_arcs][0] = b->arcs[k][0];
-            nb->arcs[nb->nb_arcs][1] = b->arcs[k][1];
-            nb->nb_arcs++;
-        }
+        for (int k = 0; k < b->nb_arcs; k++)
+            ajouter_arc(nb, b->arcs[k][0], b->arcs[k][1]);
 
         // 0) Assurer la connexité en priorité tant qu'il reste des emplacements
         int parent_conn[total];
@@ -370,19 +524,25 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
             int cj = nb->arcs[k][1];
             unite_parent(fi, n + cj, parent_conn);
         }
+        // Un arc n'est ajouté que s'il relie deux composantes (sinon il fermerait
+        // un cycle) ; on repasse tant qu'une passe a fusionné des composantes.
         int root0 = find_parent(0, parent_conn);
-        for (int node = 0; node < total && nb->nb_arcs < n + m - 1; node++) {
-            if (find_parent(node, parent_conn) != root0) {
-                int fi, cj;
-                if (node < n) { fi = node; cj = 0; }
-                else         { fi = 0;    cj = node - n; }
-
-                if (!arc_existe(nb, nb->nb_arcs, fi, cj)) {
-                    nb->arcs[nb->nb_arcs][0] = fi;
-                    nb->arcs[nb->nb_arcs][1] = cj;
-                    nb->nb_arcs++;
-                    unite_parent(fi, n + cj, parent_conn);
-                    root0 = find_parent(0, parent_conn);
+        int fusion = 1;
+        while (fusion && nb->nb_arcs < n + m - 1) {
+            fusion = 0;
+            for (int node = 0; node < total && nb->nb_arcs < n + m - 1; node++) {
+                if (find_parent(node, parent_conn) != root0) {
+                    int fi, cj;
+                    if (node < n) { fi = node; cj = 0; }
+                    else         { fi = 0;    cj = node - n; }
+
+                    if (!arc_dans_base(nb, fi, cj) &&
+                        find_parent(fi, parent_conn) != find_parent(n + cj, parent_conn)) {
+                        ajouter_arc(nb, fi, cj);
+                        unite_parent(fi, n + cj, parent_conn);
+                        root0 = find_parent(0, parent_conn);
+                        fusion = 1;
+                    }
                 }
             }
         }
@@ -391,10 +551,8 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
         for (int cj = 0; cj < m && nb->nb_arcs < n + m - 1; cj++) {
             if (deg[n + cj] == 0) {
                 int fi = 0;
-                if (!arc_existe(nb, nb->nb_arcs, fi, cj)) {
-                    nb->arcs[nb->nb_arcs][0] = fi;
-                    nb->arcs[nb->nb_arcs][1] = cj;
-                    nb->nb_arcs++;
+                if (!arc_dans_base(nb, fi, cj)) {
+                    ajouter_arc(nb, fi, cj);
                 }
             }
         }
@@ -403,10 +561,8 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
         for (int fi = 0; fi < n && nb->nb_arcs < n + m - 1; fi++) {
             if (deg[fi] == 0) {
                 int cj = 0;
-                if (!arc_existe(nb, nb->nb_arcs, fi, cj)) {
-                    nb->arcs[nb->nb_arcs][0] = fi;
-                    nb->arcs[nb->nb_arcs][1] = cj;
-                    nb->nb_arcs++;
+                if (!arc_dans_base(nb, fi, cj)) {
+                    ajouter_arc(nb, fi, cj);
                 }
             }
         }
@@ -414,16 +570,14 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
         // 3) Si toujours pas assez d'arcs, ajouter des arcs distincts simples pour atteindre n+m-1
         for (int fi = 0; fi < n && nb->nb_arcs < n + m - 1; fi++) {
             for (int cj = 0; cj < m && nb->nb_arcs < n + m - 1; cj++) {
-                if (!arc_existe(nb, nb->nb_arcs, fi, cj)) {
-                    nb->arcs[nb->nb_arcs][0] = fi;
-                    nb->arcs[nb->nb_arcs][1] = cj;
-                    nb->nb_arcs++;
+                if (!arc_dans_base(nb, fi, cj)) {
+                    ajouter_arc(nb, fi, cj);
                 }
             }
         }
 
         trace("Base corrigée avec %d arcs (ajouts nuls) pour obtenir un arbre.\n", nb->nb_arcs);
-        // Les x correspondants restent à 0 dans s->x (degenerescence)
+        // Ces cases restent absentes de la solution (x = 0, degenerescence)
         return nb;
     }
 
@@ -432,7 +586,7 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
 
     if (!trouver_cycle(b, n, m, cycle_noeuds, &cycle_len) || cycle_len < 4) {
         trace("Aucun cycle détecté (ou cycle trop court) alors que nb_arcs=%d.\n", b->nb_arcs);
-        return construire_base(s);
+        return construire_base_dans(s, a);
     }
 
     int nb_arcs_cycle = cycle_len - 1; // dernier noeud répété
@@ -450,7 +604,7 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
         else if (v < n && u >= n) { fi = v; cj = u - n; }
         else {
             trace("Cycle non biparti détecté, abandon de la correction.\n");
-            return construire_base(s);
+            return construire_base_dans(s, a);
         }
         cycle_i[e] = fi;
         cycle_j[e] = cj;
@@ -461,14 +615,14 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
     int theta = INT_MAX;
     for (int e = 0; e < nb_arcs_cycle; e++) {
         if (signe[e] == -1) {
-            int x = s->x[cycle_i[e]][cycle_j[e]];
+            int x = sol_x(s, cycle_i[e], cycle_j[e]);
             if (x < theta) theta = x;
         }
     }
 
     if (theta == INT_MAX) {
         trace("Correction : aucun arc '-' ? Impossible de pousser un flux.\n");
-        return construire_base(s);
+        return construire_base_dans(s, a);
     }
 
     trace("\n>>> Correction de cycle détecté (nb_arcs=%d). Cycle :\n", b->nb_arcs);
@@ -479,7 +633,7 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
 
     // Appliquer +theta / -theta le long du cycle
     for (int e = 0; e < nb_arcs_cycle; e++) {
-        s->x[cycle_i[e]][cycle_j[e]] += signe[e] * theta;
+        sol_ajouter(s, cycle_i[e], cycle_j[e], signe[e] * theta);
     }
 
     // Identifier l'arc qui sort (tombé à 0)
@@ -488,7 +642,7 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
         if (signe[e] == -1) {
             int ii = cycle_i[e];
             int jj = cycle_j[e];
-            if (s->x[ii][jj] == 0) {
+            if (sol_x(s, ii, jj) == 0) {
                 i_sortie = ii;
                 j_sortie = jj;
                 break;
@@ -503,14 +657,29 @@ Base *corriger_base(const Base *b, Solution *s, int n, int m)
     }
 
     // Re-construire la base à partir de la solution modifiée
-    return construire_base(s);
+    return construire_base_dans(s, a);
+}
+
+Base *corriger_base(const Base *b, Solution *s, int n, int m)
+{
+    return corriger_base_dans(b, s, n, m, NULL);
 }
 
 // ---------- Libération ----------
 
 void liberer_base(Base *b)
 {
-    if (!b) return;
-    if (b->arcs) free(b->arcs);
+    if (!b || b->arene) return;
+    free(b->arcs);
+    free(b->index);
     free(b);
-}
\ No newline at end of file
+}
+
+void liberer_adjacence(AdjacenceBase *adj)
+{
+    if (!adj || adj->arene) return;
+    free(adj->debut);
+    free(adj->voisins);
+    free(adj->arc);
+    free(adj);
+}
@@ -0,0 +1,78 @@
+#include <stdlib.h>
+#include <math.h>
+#include "caracteristiques.h"
+#include "couts.h"
+#include "tuiles.h"
+
+// Coefficient de variation à partir de la somme et de la somme des carrés
+static double variation(double somme, double carres, double nb)
+{
+    if (nb <= 0 || somme == 0)
+        return 0.0;
+    double moyenne = somme / nb;
+    double variance = carres / nb - moyenne * moyenne;
+    return (variance > 0) ? sqrt(variance) / fabs(moyenne) : 0.0;
+}
+
+void calculer_caracteristiques(const Probleme *p, Caracteristiques *c)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    c->taille = n + m;
+    c->rapport = (n > 0 && m > 0) ? (double)((n > m) ? n : m) / ((n > m) ? m : n) : 0.0;
+
+    double somme = 0, carres = 0, nb_couts = 0;
+    double somme_min = 0, carres_min = 0, nb_min = 0;
+
+    if (est_creux(p)) {
+        for (int i = 0; i < n; i++) {
+            long long minimum = 0;
+            for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++) {
+                double x = p->arc_cout[k];
+                somme += x;
+                carres += x * x;
+                if (k == p->debut_ligne[i] || p->arc_cout[k] < minimum)
+                    minimum = p->arc_cout[k];
+            }
+            if (p->debut_ligne[i + 1] > p->debut_ligne[i]) {
+                somme_min += (double)minimum;
+                carres_min += (double)minimum * minimum;
+                nb_min++;
+            }
+        }
+        nb_couts = p->debut_ligne[n];
+    } else {
+        long long *ligne = malloc((size_t)m * sizeof(long long));
+        int *tampon = malloc((size_t)taille_tampon_couts(p) * sizeof(int));
+        for (int i = 0; ligne && tampon && i < n; i++) {
+            entrer_tuile(p, i);
+            copier_ligne_couts(p, i, tampon, ligne);
+            long long minimum = ligne[0];
+            for (int j = 0; j < m; j++) {
+                double x = (double)ligne[j];
+                somme += x;
+                carres += x * x;
+                if (ligne[j] < minimum)
+                    minimum = ligne[j];
+            }
+            somme_min += (double)minimum;
+            carres_min += (double)minimum * minimum;
+            nb_min++;
+        }
+        nb_couts = nb_min * m;
+        free(ligne);
+        free(tampon);
+    }
+
+    c->etendue = variation(somme, carres, nb_couts);
+    c->dispersion_minima = variation(somme_min, carres_min, nb_min);
+    c->densite = (n > 0 && m > 0) ? nb_couts / ((double)n * m) : 0.0;
+
+    double somme_prov = 0, carres_prov = 0;
+    for (int i = 0; i < n; i++) {
+        somme_prov += p->provisions[i];
+        carres_prov += (double)p->provisions[i] * p->provisions[i];
+    }
+    c->desequilibre = variation(somme_prov, carres_prov, n);
+}
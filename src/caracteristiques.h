@@ -0,0 +1,24 @@
+#ifndef CARACTERISTIQUES_H
+#define CARACTERISTIQUES_H
+
+#include "problem.h"
+
+/*
+ * Caractéristiques d'une instance, calculées en un seul parcours des lignes
+ * de coûts, pour choisir la méthode initiale (choix_methode.h). Les
+ * dispersions sont des coefficients de variation (écart type / moyenne),
+ * donc sans unité. En variante creuse, seuls les arcs autorisés comptent.
+ */
+
+typedef struct {
+    int taille;                 // n + m
+    double rapport;             // max(n, m) / min(n, m)
+    double etendue;             // dispersion des coûts
+    double dispersion_minima;   // dispersion des minima de ligne
+    double desequilibre;        // dispersion des provisions
+    double densite;             // part des paires (i,j) autorisées
+} Caracteristiques;
+
+void calculer_caracteristiques(const Probleme *p, Caracteristiques *c);
+
+#endif
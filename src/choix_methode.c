@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "choix_methode.h"
+#include "heuristiques.h"
+#include "tarification.h"
+
+#define S SANS_BORNE
+
+// Table fournie : `complexite --calibrer` sur la machine de développement,
+// cases retenues par au moins quatre calibrations sur cinq. Jusqu'à 64
+// sites, le minimum par ligne (ou le coût minimal, à quelques µs près) avec
+// la liste de candidats ; au-delà, la tarification par blocs, avec
+// Balas-Hammer, sauf le coût minimal sur les instances carrées à coûts
+// resserrés (grandes, ou à provisions déséquilibrées). Les instances
+// creuses, non calibrées, gardent Balas-Hammer et les blocs.
+static const TableChoix table_defaut = {
+    5, {
+        {  64, S, S,   S, S,   0.5, "ml", "candidats" },
+        { 400, 2, 0.4, S, 0.5, 0.5, "bh", "blocs" },
+        {   S, 2, 0.4, S, S,   0.5, "cm", "blocs" },
+        {   S, S, S,   S, S,   0.5, "bh", "blocs" },
+        {   S, S, S,   S, S,   0.0, "bh", "blocs" },
+    }
+};
+
+static const RegleChoix regle_secours = { S, S, S, S, S, 0.0, "bh", "dantzig" };
+
+#undef S
+
+const TableChoix *table_choix_defaut(void)
+{
+    return &table_defaut;
+}
+
+static int satisfaite(const RegleChoix *r, const Caracteristiques *c)
+{
+    return c->taille <= r->taille_max
+        && c->rapport <= r->rapport_max
+        && c->etendue <= r->etendue_max
+        && c->dispersion_minima <= r->dispersion_max
+        && c->desequilibre <= r->desequilibre_max
+        && c->densite >= r->densite_min;
+}
+
+const RegleChoix *choisir_regle(const TableChoix *t, const Caracteristiques *c)
+{
+    for (int k = 0; k < t->nb_regles; k++) {
+        const RegleChoix *r = &t->regles[k];
+        if (satisfaite(r, c) && trouver_heuristique(r->methode)
+            && tarification_par_nom(r->tarification) >= 0)
+            return r;
+    }
+    return &regle_secours;
+}
+
+int definir_table_choix(TableChoix *t, const RegleChoix *regles, int nb)
+{
+    if (nb < 0 || nb > MAX_REGLES_CHOIX)
+        return -1;
+    memcpy(t->regles, regles, (size_t)nb * sizeof(RegleChoix));
+    t->nb_regles = nb;
+    return 0;
+}
+
+// Borne lue : nombre ou '*'
+static int lire_borne(const char *mot, double *x)
+{
+    if (strcmp(mot, "*") == 0) {
+        *x = SANS_BORNE;
+        return 0;
+    }
+    char *fin;
+    *x = strtod(mot, &fin);
+    return (fin == mot || *fin != '\0') ? -1 : 0;
+}
+
+int charger_table_choix(TableChoix *t, const char *fichier)
+{
+    FILE *f = fopen(fichier, "r");
+    if (!f)
+        return -1;
+
+    RegleChoix regles[MAX_REGLES_CHOIX];
+    int nb = 0, erreur = 0;
+    char ligne[512];
+
+    while (!erreur && fgets(ligne, sizeof(ligne), f)) {
+        char mots[8][64];
+        int lus = sscanf(ligne, "%63s %63s %63s %63s %63s %63s %63s %63s",
+                         mots[0], mots[1], mots[2], mots[3], mots[4], mots[5], mots[6], mots[7]);
+        if (lus <= 0 || mots[0][0] == '#')
+            continue;
+        if (lus == 7)
+            strcpy(mots[7], "dantzig");   // table d'avant la tarification partielle
+        else if (lus != 8 || tarification_par_nom(mots[7]) < 0)
+            lus = 0;
+        if (lus == 0 || nb == MAX_REGLES_CHOIX || strlen(mots[6]) >= sizeof(regles[nb].methode)) {
+            erreur = 1;
+            break;
+        }
+
+        RegleChoix *r = &regles[nb++];
+        double densite = 0.0;
+        erreur = lire_borne(mots[0], &r->taille_max) || lire_borne(mots[1], &r->rapport_max)
+              || lire_borne(mots[2], &r->etendue_max) || lire_borne(mots[3], &r->dispersion_max)
+              || lire_borne(mots[4], &r->desequilibre_max) || lire_borne(mots[5], &densite);
+        r->densite_min = (densite == SANS_BORNE) ? 0.0 : densite;
+        strcpy(r->methode, mots[6]);
+        strcpy(r->tarification, mots[7]);
+    }
+    fclose(f);
+
+    if (erreur || nb == 0)
+        return -1;
+    return definir_table_choix(t, regles, nb);
+}
+
+static void ecrire_borne(FILE *f, double x)
+{
+    if (x >= SANS_BORNE)
+        fprintf(f, " %12s", "*");
+    else
+        fprintf(f, " %12g", x);
+}
+
+void ecrire_table_choix(FILE *f, const RegleChoix *regles, int nb)
+{
+    fprintf(f, "# taille_max  rapport_max  etendue_max dispersion_max desequilibre_max densite_min methode tarification\n");
+    for (int k = 0; k < nb; k++) {
+        const RegleChoix *r = &regles[k];
+        ecrire_borne(f, r->taille_max);
+        ecrire_borne(f, r->rapport_max);
+        ecrire_borne(f, r->etendue_max);
+        ecrire_borne(f, r->dispersion_max);
+        ecrire_borne(f, r->desequilibre_max);
+        fprintf(f, " %12g %s %s\n", r->densite_min, r->methode, r->tarification);
+    }
+}
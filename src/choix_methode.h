@@ -0,0 +1,55 @@
+#ifndef CHOIX_METHODE_H
+#define CHOIX_METHODE_H
+
+#include <stdio.h>
+#include "caracteristiques.h"
+
+/*
+ * Choix automatique de la méthode initiale et de la tarification du
+ * marche-pied (tarification.h) par une table de décision : une liste de
+ * règles, chacune bornant les caractéristiques de l'instance
+ * (caracteristiques.h), et la première règle satisfaite donne le couple.
+ *
+ * Une table est fournie, calibrée sur des instances générées par
+ * `complexite --calibrer`, qui réécrit la table pour la machine courante.
+ * Format texte, une règle par ligne ('*' : sans borne, '#' : commentaire) :
+ *   taille_max rapport_max etendue_max dispersion_max desequilibre_max densite_min methode [tarification]
+ * (tarification absente : dantzig).
+ *
+ * La table fournie est en lecture seule ; chaque contexte de résolution
+ * garde sa propre table (transport_charger_table_choix), sans état partagé.
+ */
+
+#define SANS_BORNE 1e300
+#define MAX_REGLES_CHOIX 64
+
+typedef struct {
+    double taille_max;
+    double rapport_max;
+    double etendue_max;
+    double dispersion_max;
+    double desequilibre_max;
+    double densite_min;
+    char methode[16];           // nom dans le registre (heuristiques.h)
+    char tarification[16];      // "dantzig", "blocs" ou "candidats"
+} RegleChoix;
+
+typedef struct {
+    int nb_regles;
+    RegleChoix regles[MAX_REGLES_CHOIX];
+} TableChoix;
+
+const TableChoix *table_choix_defaut(void);
+
+// Première règle de t satisfaite par ces caractéristiques, de méthode et de
+// tarification connues (à défaut : Balas-Hammer, Dantzig)
+const RegleChoix *choisir_regle(const TableChoix *t, const Caracteristiques *c);
+
+// Remplissent t. Renvoient 0, ou -1 (fichier illisible ou règle invalide)
+// en laissant t inchangée.
+int charger_table_choix(TableChoix *t, const char *fichier);
+int definir_table_choix(TableChoix *t, const RegleChoix *regles, int nb);
+
+void ecrire_table_choix(FILE *f, const RegleChoix *regles, int nb);
+
+#endif
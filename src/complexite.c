@@ -1,108 +1,32 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <limits.h>
-#include <unistd.h>
-#include <fcntl.h>
-
-#include "problem.h"
-#include "nord_ouest.h"
-#include "balas_hammer.h"
-#include "base.h"
-
-/*
- * Outils internes -----------------------------------------------------------
- */
-
-/* Redirige temporairement stdout vers /dev/null pour rendre les algorithmes silencieux. */
-static int silence_stdout(int *saved_fd)
-{
-    if (!saved_fd)
-        return -1;
-
-    fflush(stdout);
-    int duplicate = dup(fileno(stdout));
-    if (duplicate < 0)
-        return -1;
-
-    int null_fd = open("/dev/null", O_WRONLY);
-    if (null_fd < 0) {
-        close(duplicate);
-        return -1;
-    }
-
-    if (dup2(null_fd, fileno(stdout)) < 0) {
-        close(duplicate);
-        close(null_fd);
-        return -1;
-    }
-
-    close(null_fd);
-    *saved_fd = duplicate;
-    return 0;
-}
-
-static void restaurer_stdout(int saved_fd)
-{
-    if (saved_fd < 0)
-        return;
-
-    fflush(stdout);
-    dup2(saved_fd, fileno(stdout));
-    close(saved_fd);
-}
-
-static int **allouer_matrice_int(int n, int m)
-{
-    int **mat = calloc((size_t)n, sizeof(int *));
-    if (!mat)
-        return NULL;
-
-    for (int i = 0; i < n; i++) {
-        mat[i] = malloc((size_t)m * sizeof(int));
-        if (!mat[i]) {
-            for (int k = 0; k < i; k++)
-                free(mat[k]);
-            free(mat);
-            return NULL;
-        }
-    }
-
-    return mat;
-}
+#include <string.h>
+
+#include "transport.h"
+#include "couts.h"
+#include "tuiles.h"
+#include "arene.h"
+#include "equipe.h"
+#include "heuristiques.h"
+#include "caracteristiques.h"
+#include "choix_methode.h"
+#include "petit_probleme.h"
+#include "tarification.h"
 
 /*
  * Génération / destruction d'un problème aléatoire -------------------------
  */
 
-Probleme *generer_probleme_aleatoire(int n)
+Probleme *generer_probleme_aleatoire(int n, Arene *a)
 {
     if (n <= 0)
         return NULL;
 
-    Probleme *p = calloc(1, sizeof(Probleme));
+    Probleme *p = creer_probleme_dans(a, n, n);
     if (!p)
         return NULL;
 
-    p->nb_fournisseurs = n;
-    p->nb_clients = n;
-
-    p->couts = allouer_matrice_int(n, n);
-    p->provisions = calloc((size_t)n, sizeof(int));
-    p->commandes = calloc((size_t)n, sizeof(int));
-
-    if (!p->couts || !p->provisions || !p->commandes) {
-        if (p->couts) {
-            for (int i = 0; i < n; i++)
-                free(p->couts[i]);
-            free(p->couts);
-        }
-        free(p->provisions);
-        free(p->commandes);
-        free(p);
-        return NULL;
-    }
-
     /* Génération de la matrice temporaire implicite pour provisions/commandes. */
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
@@ -115,557 +39,497 @@ Probleme *generer_probleme_aleatoire(int n)
     /* Génération de la matrice de coûts. */
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++)
-            p->couts[i][j] = (rand() % 100) + 1;
+            fixer_cout(p, i, j, (rand() % 100) + 1);
     }
 
+    adapter_largeur_couts(p);
+
     return p;
 }
 
 void detruire_probleme(Probleme *p)
 {
-    if (!p)
-        return;
-
-    if (p->couts) {
-        for (int i = 0; i < p->nb_fournisseurs; i++)
-            free(p->couts[i]);
-        free(p->couts);
-    }
-
-    free(p->provisions);
-    free(p->commandes);
-    free(p);
+    liberer_probleme(p);
 }
 
-/*
- * Potentiels et coûts marginaux (versions silencieuses et dynamiques) -------
- */
-
-static int choisir_sommet_depart_dyn(const Base *b, int total, int n)
+/* Problème n x m de forme donnée : coûts tirés dans [cout_min, cout_max],
+   provisions à peu près égales ou, avec desequilibre, une ligne sur dix
+   dix fois plus chargée ; les commandes se partagent le même total. */
+static Probleme *generer_probleme_forme(int n, int m, int cout_min, int cout_max,
+                                        int desequilibre, Arene *a)
 {
-    int *degres = calloc((size_t)total, sizeof(int));
-    if (!degres)
-        return 0;
-
-    for (int k = 0; k < b->nb_arcs; k++) {
-        int fi = b->arcs[k][0];
-        int cj = b->arcs[k][1];
-        int u = fi;
-        int v = n + cj;
-
-        if (u >= 0 && u < total)
-            degres[u]++;
-        if (v >= 0 && v < total)
-            degres[v]++;
-    }
+    Probleme *p = creer_probleme_dans(a, n, m);
+    if (!p)
+        return NULL;
 
-    int sommet = 0;
-    int deg_max = -1;
-    for (int i = 0; i < total; i++) {
-        if (degres[i] > deg_max) {
-            deg_max = degres[i];
-            sommet = i;
-        }
+    long long total = 0;
+    for (int i = 0; i < n; i++) {
+        p->provisions[i] = 50 + rand() % 101;
+        if (desequilibre && rand() % 10 == 0)
+            p->provisions[i] *= 10;
+        total += p->provisions[i];
     }
 
-    free(degres);
-    return sommet;
-}
-
-static void calculer_potentiels_dyn(const Probleme *p, const Base *b,
-                                     int *pot_f, int *pot_c)
-{
-    int n = p->nb_fournisseurs;
-    int m = p->nb_clients;
-    int total = n + m;
-
-    if (!b || total <= 0)
-        return;
-
-    int *pot_sommet = calloc((size_t)total, sizeof(int));
-    int *visite = calloc((size_t)total, sizeof(int));
-    int *file = malloc((size_t)total * sizeof(int));
-
-    if (!pot_sommet || !visite || !file) {
-        free(pot_sommet);
-        free(visite);
-        free(file);
-        return;
+    long long poids_total = 0, reparti = 0;
+    for (int j = 0; j < m; j++) {
+        p->commandes[j] = 50 + rand() % 101;
+        poids_total += p->commandes[j];
     }
-
-    int racine = choisir_sommet_depart_dyn(b, total, n);
-    int tete = 0, queue = 0;
-    file[queue++] = racine;
-    visite[racine] = 1;
-    pot_sommet[racine] = 0;
-
-    while (tete < queue) {
-        int u = file[tete++];
-        int est_fournisseur = (u < n);
-
-        for (int i = 0; i < b->nb_arcs; i++) {
-            int fi = b->arcs[i][0];
-            int cj = b->arcs[i][1];
-            int noeud_f = fi;
-            int noeud_c = n + cj;
-            int cout = p->couts[fi][cj];
-
-            if (est_fournisseur && u == noeud_f) {
-                int v = noeud_c;
-                if (!visite[v]) {
-                    pot_sommet[v] = pot_sommet[u] - cout;
-                    visite[v] = 1;
-                    file[queue++] = v;
-                }
-            } else if (!est_fournisseur && u == noeud_c) {
-                int v = noeud_f;
-                if (!visite[v]) {
-                    pot_sommet[v] = cout + pot_sommet[u];
-                    visite[v] = 1;
-                    file[queue++] = v;
-                }
-            }
-        }
+    for (int j = 0; j < m; j++) {
+        int q = (j == m - 1) ? (int)(total - reparti)
+                             : (int)(total * p->commandes[j] / poids_total);
+        p->commandes[j] = q;
+        reparti += q;
     }
 
     for (int i = 0; i < n; i++)
-        pot_f[i] = pot_sommet[i];
-
-    for (int j = 0; j < m; j++)
-        pot_c[j] = pot_sommet[n + j];
-
-    free(pot_sommet);
-    free(visite);
-    free(file);
-}
-
-static int arc_dans_base_simple(const Base *b, int i, int j)
-{
-    for (int k = 0; k < b->nb_arcs; k++) {
-        if (b->arcs[k][0] == i && b->arcs[k][1] == j)
-            return 1;
-    }
-    return 0;
-}
-
-/* Renvoie 1 si optimal, 0 sinon (avec i_entree/j_entree renseignés). */
-static int trouver_arc_ameliorant(const Probleme *p, const Base *b,
-                                  const int *pot_f, const int *pot_c,
-                                  int *i_entree, int *j_entree)
-{
-    int n = p->nb_fournisseurs;
-    int m = p->nb_clients;
+        for (int j = 0; j < m; j++)
+            fixer_cout(p, i, j, cout_min + rand() % (cout_max - cout_min + 1));
 
-    int meilleur_i = -1;
-    int meilleur_j = -1;
-    int meilleur_marginal = 0;
-
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < m; j++) {
-            if (arc_dans_base_simple(b, i, j))
-                continue;
-
-            int cp = pot_f[i] - pot_c[j];
-            int marginal = p->couts[i][j] - cp;
-
-            if (marginal < meilleur_marginal) {
-                meilleur_marginal = marginal;
-                meilleur_i = i;
-                meilleur_j = j;
-            }
-        }
-    }
-
-    if (meilleur_i == -1)
-        return 1; /* optimale */
-
-    if (i_entree)
-        *i_entree = meilleur_i;
-    if (j_entree)
-        *j_entree = meilleur_j;
-
-    return 0;
+    adapter_largeur_couts(p);
+    return p;
 }
 
 /*
- * Marche-pied (version silencieuse) ----------------------------------------
+ * Boucle d'expérimentation --------------------------------------------------
  */
 
-static int trouver_chemin_dyn(const Base *b, int n, int m, int source, int cible, int *parent)
+/* Volume de coûts lu par passe de tarification du marche-pied (lecture par tuiles) */
+static double octets_par_iteration(const ResultatTransport *res)
 {
-    int total = n + m;
-    int *file = malloc((size_t)total * sizeof(int));
-    if (!file)
-        return 0;
-
-    for (int i = 0; i < total; i++)
-        parent[i] = -1;
-
-    int tete = 0, queue = 0;
-    file[queue++] = source;
-    parent[source] = source;
-
-    while (tete < queue && parent[cible] == -1) {
-        int u = file[tete++];
-
-        for (int k = 0; k < b->nb_arcs; k++) {
-            int fi = b->arcs[k][0];
-            int cj = b->arcs[k][1];
-
-            int a = fi;
-            int c = n + cj;
-            int v = -1;
-
-            if (u == a)
-                v = c;
-            else if (u == c)
-                v = a;
-
-            if (v >= 0 && parent[v] == -1) {
-                parent[v] = u;
-                file[queue++] = v;
-            }
-        }
-    }
-
-    free(file);
-    return parent[cible] != -1;
+    if (!res || res->nb_iterations <= 0)
+        return 0.0;
+    return (double)res->octets_lus / res->nb_iterations;
 }
 
-static int marche_pied_silencieux(const Base *b, Solution *s,
-                                  int i_entree, int j_entree,
-                                  int *i_sortie_ptr, int *j_sortie_ptr)
+void lancer_etude_complexite(size_t taille_tuile, int nb_threads)
 {
-    int n = s->nb_fournisseurs;
-    int m = s->nb_clients;
-    int total = n + m;
-
-    int *parent = malloc((size_t)total * sizeof(int));
-    int *chemin_noeuds = malloc((size_t)total * sizeof(int));
-    int *cycle_i = NULL;
-    int *cycle_j = NULL;
-    int *signe = NULL;
-
-    if (!parent || !chemin_noeuds) {
-        free(parent);
-        free(chemin_noeuds);
-        return -1;
-    }
-
-    int noeud_f = i_entree;
-    int noeud_c = n + j_entree;
-
-    if (!trouver_chemin_dyn(b, n, m, noeud_f, noeud_c, parent)) {
-        free(parent);
-        free(chemin_noeuds);
-        if (i_sortie_ptr)
-            *i_sortie_ptr = -1;
-        if (j_sortie_ptr)
-            *j_sortie_ptr = -1;
-        return -1;
-    }
+    int tailles[] = {10, 40, 100, 200, 400, 1000 };
+    int nb_tailles = (int)(sizeof(tailles) / sizeof(tailles[0]));
+    int repetitions = 100;
 
-    int len = 0;
-    int cur = noeud_c;
-    while (1) {
-        chemin_noeuds[len++] = cur;
-        if (cur == noeud_f || len > total)
-            break;
-        cur = parent[cur];
+    FILE *csv = fopen("resultats_complexite.csv", "w");
+    if (!csv) {
+        fprintf(stderr, "Impossible d'ouvrir resultats_complexite.csv en écriture\n");
+        return;
     }
 
-    for (int i = 0; i < len / 2; i++) {
-        int tmp = chemin_noeuds[i];
-        chemin_noeuds[i] = chemin_noeuds[len - 1 - i];
-        chemin_noeuds[len - 1 - i] = tmp;
+    /* Les problèmes générés vivent dans leur arène, vidée entre deux
+       répétitions ; le contexte garde sa propre mémoire de résolution.
+       Ni l'un ni l'autre n'appelle plus malloc après la première taille. */
+    /* ctx_par refait Balas-Hammer avec nb_threads threads pour mesurer
+       l'accélération (temps écoulés) ; la proposition doit être identique. */
+    Arene *arene = creer_arene((size_t)1 << 20);
+    ContexteTransport *ctx = transport_creer_contexte();
+    ContexteTransport *ctx_par = transport_creer_contexte();
+    if (!arene || !ctx || !ctx_par) {
+        detruire_arene(arene);
+        transport_detruire_contexte(ctx);
+        transport_detruire_contexte(ctx_par);
+        fclose(csv);
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return;
     }
 
-    int cycle_taille = len;
-    cycle_i = malloc((size_t)cycle_taille * sizeof(int));
-    cycle_j = malloc((size_t)cycle_taille * sizeof(int));
-    signe = malloc((size_t)cycle_taille * sizeof(int));
-
-    if (!cycle_i || !cycle_j || !signe) {
-        free(parent);
-        free(chemin_noeuds);
-        free(cycle_i);
-        free(cycle_j);
-        free(signe);
-        return -1;
+    transport_definir_threads(ctx_par, nb_threads);
+    printf("Balas-Hammer parallèle : %d thread(s)\n", nb_threads);
+
+    /* Les autres méthodes du registre (coût minimal, minimum par ligne,
+       Russell...) ajoutent chacune trois colonnes en fin de ligne. */
+    fprintf(csv, "n;iteration;theta_no;theta_bh;t_no;t_bh;total_no;total_bh;ratio;"
+                 "octets_iter_no;octets_iter_bh;theta_bh_par;acceleration_bh");
+    for (int h = 0; h < nb_heuristiques(); h++) {
+        const char *nom = heuristique(h)->nom;
+        if (strcmp(nom, "no") != 0 && strcmp(nom, "bh") != 0)
+            fprintf(csv, ";theta_%s;t_%s;total_%s", nom, nom, nom);
     }
+    fprintf(csv, ";theta_pf;t_pf;total_pf;choix_pf;theta_auto;t_auto;total_auto;choix_auto\n");
 
-    cycle_i[0] = i_entree;
-    cycle_j[0] = j_entree;
-
-    for (int e = 0; e < len - 1; e++) {
-        int u = chemin_noeuds[e];
-        int v = chemin_noeuds[e + 1];
-        int fi, cj;
-
-        if (u < n && v >= n) {
-            fi = u;
-            cj = v - n;
-        } else if (v < n && u >= n) {
-            fi = v;
-            cj = u - n;
-        } else {
-            free(parent);
-            free(chemin_noeuds);
-            free(cycle_i);
-            free(cycle_j);
-            free(signe);
-            return -1;
-        }
+    for (int idx = 0; idx < nb_tailles; idx++) {
+        int n = tailles[idx];
+        printf("Taille %d...\n", n);
+        double somme_seq = 0.0, somme_par = 0.0;
 
-        cycle_i[e + 1] = fi;
-        cycle_j[e + 1] = cj;
-    }
+        for (int k = 0; k < repetitions; k++) {
+            Probleme *p = generer_probleme_aleatoire(n, arene);
+            if (!p) {
+                fprintf(stderr, "Generation du probleme (%d) impossible\n", n);
+                continue;
+            }
+            activer_tuilage(p, taille_tuile);
+
+            ResultatTransport res_no, res_bh;
+            int ok_no = (transport_solve(ctx, p, "no", &res_no) == TRANSPORT_OK);
+            int ok_bh = (transport_solve(ctx, p, "bh", &res_bh) == TRANSPORT_OK);
+
+            ResultatTransport res_par;
+            int ok_par = ok_bh && (transport_solve(ctx_par, p, "bh", &res_par) == TRANSPORT_OK);
+            if (ok_par && res_par.cout_total != res_bh.cout_total)
+                fprintf(stderr, "Balas-Hammer parallèle : coût %lld au lieu de %lld (n = %d)\n",
+                        res_par.cout_total, res_bh.cout_total, n);
+            double theta_bh_par = ok_par ? res_par.temps_initial_reel : -1.0;
+            double acceleration = (ok_par && theta_bh_par > 0)
+                                ? res_bh.temps_initial_reel / theta_bh_par : 0.0;
+            if (ok_par) {
+                somme_seq += res_bh.temps_initial_reel;
+                somme_par += theta_bh_par;
+            }
 
-    for (int e = 0; e < cycle_taille; e++)
-        signe[e] = (e % 2 == 0) ? 1 : -1;
+            double theta_no = ok_no ? res_no.temps_initial : -1.0;
+            double theta_bh = ok_bh ? res_bh.temps_initial : -1.0;
+            double t_no = ok_no ? res_no.temps_marche_pied : -1.0;
+            double t_bh = ok_bh ? res_bh.temps_marche_pied : -1.0;
+            double octets_no = octets_par_iteration(ok_no ? &res_no : NULL);
+            double octets_bh = octets_par_iteration(ok_bh ? &res_bh : NULL);
 
-    int theta = INT_MAX;
-    for (int e = 0; e < cycle_taille; e++) {
-        if (signe[e] == -1) {
-            int x = s->x[cycle_i[e]][cycle_j[e]];
-            if (x < theta)
-                theta = x;
-        }
-    }
+            double total_no = (theta_no >= 0 && t_no >= 0) ? theta_no + t_no : -1.0;
+            double total_bh = (theta_bh >= 0 && t_bh >= 0) ? theta_bh + t_bh : -1.0;
+            double ratio = (total_bh > 0) ? (total_no / total_bh) : 0.0;
 
-    if (theta == INT_MAX)
-        theta = 0;
+            fprintf(csv, "%d;%d;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;%.0f;%.0f;%.6f;%.3f",
+                    n, k,
+                    theta_no, theta_bh,
+                    t_no, t_bh,
+                    total_no, total_bh,
+                    ratio,
+                    octets_no, octets_bh,
+                    theta_bh_par, acceleration);
+
+            for (int h = 0; h < nb_heuristiques(); h++) {
+                const char *nom = heuristique(h)->nom;
+                if (strcmp(nom, "no") == 0 || strcmp(nom, "bh") == 0)
+                    continue;
+
+                ResultatTransport res_h;
+                int ok_h = (transport_solve(ctx, p, nom, &res_h) == TRANSPORT_OK);
+                if (ok_h && ok_bh && res_h.cout_total != res_bh.cout_total)
+                    fprintf(stderr, "Méthode %s : coût final %lld au lieu de %lld (n = %d)\n",
+                            nom, res_h.cout_total, res_bh.cout_total, n);
+                double theta = ok_h ? res_h.temps_initial : -1.0;
+                double t = ok_h ? res_h.temps_marche_pied : -1.0;
+                fprintf(csv, ";%.6f;%.6f;%.6f", theta, t, ok_h ? theta + t : -1.0);
+            }
 
-    for (int e = 0; e < cycle_taille; e++)
-        s->x[cycle_i[e]][cycle_j[e]] += signe[e] * theta;
+            /* Portefeuille : temps écoulé de toutes les méthodes en parallèle,
+               puis marche-pied depuis la proposition retenue */
+            ResultatTransport res_pf;
+            int ok_pf = (transport_solve(ctx, p, TRANSPORT_PORTEFEUILLE, &res_pf) == TRANSPORT_OK);
+            if (ok_pf && ok_bh && res_pf.cout_total != res_bh.cout_total)
+                fprintf(stderr, "Portefeuille : coût final %lld au lieu de %lld (n = %d)\n",
+                        res_pf.cout_total, res_bh.cout_total, n);
+            double theta_pf = ok_pf ? res_pf.temps_initial_reel : -1.0;
+            double t_pf = ok_pf ? res_pf.temps_marche_pied : -1.0;
+            fprintf(csv, ";%.6f;%.6f;%.6f;%s", theta_pf, t_pf,
+                    ok_pf ? theta_pf + t_pf : -1.0, ok_pf ? res_pf.methode : "-");
+
+            /* Choix automatique (caractéristiques comprises dans theta_auto) */
+            ResultatTransport res_auto;
+            int ok_auto = (transport_solve(ctx, p, TRANSPORT_AUTO, &res_auto) == TRANSPORT_OK);
+            double theta_auto = ok_auto ? res_auto.temps_initial : -1.0;
+            double t_auto = ok_auto ? res_auto.temps_marche_pied : -1.0;
+            fprintf(csv, ";%.6f;%.6f;%.6f;%s\n", theta_auto, t_auto,
+                    ok_auto ? theta_auto + t_auto : -1.0, ok_auto ? res_auto.methode : "-");
+
+            vider_arene(arene);
 
-    int i_sortie = -1;
-    int j_sortie = -1;
-    for (int e = 0; e < cycle_taille; e++) {
-        if (signe[e] == -1 && s->x[cycle_i[e]][cycle_j[e]] == 0) {
-            i_sortie = cycle_i[e];
-            j_sortie = cycle_j[e];
-            break;
+            if ((k + 1) % 10 == 0)
+                printf("  Iteration %d/%d terminee\n", k + 1, repetitions);
         }
+        if (somme_par > 0)
+            printf("  Accélération Balas-Hammer (%d threads) : x%.2f\n",
+                   nb_threads, somme_seq / somme_par);
     }
 
-    if (i_sortie_ptr)
-        *i_sortie_ptr = i_sortie;
-    if (j_sortie_ptr)
-        *j_sortie_ptr = j_sortie;
-
-    free(parent);
-    free(chemin_noeuds);
-    free(cycle_i);
-    free(cycle_j);
-    free(signe);
-
-    return theta;
+    transport_detruire_contexte(ctx);
+    transport_detruire_contexte(ctx_par);
+    detruire_arene(arene);
+    fclose(csv);
+    printf("Etude terminee. Resultats dans resultats_complexite.csv\n");
 }
 
-static double optimiser_par_marche_pied(const Probleme *p, Solution *s)
-{
-    int n = p->nb_fournisseurs;
-    int m = p->nb_clients;
-    int *pot_f = malloc((size_t)n * sizeof(int));
-    int *pot_c = malloc((size_t)m * sizeof(int));
-
-    if (!pot_f || !pot_c) {
-        free(pot_f);
-        free(pot_c);
-        return -1.0;
-    }
+/*
+ * Calibration de la table de décision ---------------------------------------
+ */
 
-    Base *b = construire_base(s);
-    if (!b) {
-        free(pot_f);
-        free(pot_c);
-        return -1.0;
+/* Cases de la table : taille (n + m), rapport n / m, étendue et
+   déséquilibre, chacun borné par la valeur de la case (SANS_BORNE pour la
+   dernière). Pour chaque case, des instances générées à l'intérieur :
+   dimensions, plage de coûts, provisions. */
+#define NB_TAILLES_CALIBRATION 3
+static const double bornes_taille[NB_TAILLES_CALIBRATION] = { 64, 400, SANS_BORNE };
+static const int lignes_carrees[NB_TAILLES_CALIBRATION] = { 25, 120, 240 };
+static const int lignes_allongees[NB_TAILLES_CALIBRATION] = { 12, 50, 100 };   /* m = 4 n */
+static const double bornes_rapport[2] = { 2.0, SANS_BORNE };
+static const double bornes_etendue[2] = { 0.4, SANS_BORNE };    /* coûts 60..100, puis 1..100 */
+static const double bornes_desequilibre[2] = { 0.5, SANS_BORNE };
+
+static void lancer_calibration(const char *fichier, int repetitions)
+{
+    int nb_methodes = nb_heuristiques();
+    int nb_couples = nb_methodes * NB_TARIFICATIONS;   // méthode h, tarification k : h * NB + k
+    RegleChoix regles[MAX_REGLES_CHOIX];
+    int nb_regles = 0;
+
+    Arene *arene = creer_arene((size_t)1 << 20);
+    ContexteTransport *ctx = transport_creer_contexte();
+    double *totaux = calloc((size_t)nb_couples, sizeof(double));
+    if (!arene || !ctx || !totaux) {
+        detruire_arene(arene);
+        transport_detruire_contexte(ctx);
+        free(totaux);
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return;
     }
 
-    clock_t start = clock();
-
-    int iteration = 0;
-    int optimal = 0;
-    const int iteration_max = n * m * 2; /* borne de sécurité */
-
-    while (!optimal && iteration < iteration_max) {
-        iteration++;
-
-        if (!base_est_arbre(b, n, m)) {
-            int saved_fd = -1;
-            silence_stdout(&saved_fd);
-            Base *corrigee = corriger_base(b, s, n, m);
-            restaurer_stdout(saved_fd);
-            liberer_base(b);
-            b = corrigee;
-        }
-
-        calculer_potentiels_dyn(p, b, pot_f, pot_c);
-
-        int i_entree = -1;
-        int j_entree = -1;
-        optimal = trouver_arc_ameliorant(p, b, pot_f, pot_c, &i_entree, &j_entree);
-        if (optimal)
-            break;
-
-        int i_sortie = -1;
-        int j_sortie = -1;
-        int theta = marche_pied_silencieux(b, s, i_entree, j_entree, &i_sortie, &j_sortie);
-
-        if (theta < 0)
-            break;
-
-        int remplace = 0;
-        if (i_sortie >= 0 && j_sortie >= 0) {
-            for (int k = 0; k < b->nb_arcs; k++) {
-                if (b->arcs[k][0] == i_sortie && b->arcs[k][1] == j_sortie) {
-                    b->arcs[k][0] = i_entree;
-                    b->arcs[k][1] = j_entree;
-                    remplace = 1;
-                    break;
-                }
+    printf("Calibration : %d instance(s) par case, temps total moyen (s) par méthode, "
+           "avec sa meilleure tarification\n", repetitions);
+    for (int t = 0; t < NB_TAILLES_CALIBRATION; t++)
+    for (int r = 0; r < 2; r++)
+    for (int e = 0; e < 2; e++)
+    for (int d = 0; d < 2; d++) {
+        int n = r ? lignes_allongees[t] : lignes_carrees[t];
+        int m = r ? 4 * n : n;
+        for (int h = 0; h < nb_couples; h++)
+            totaux[h] = 0.0;
+
+        Caracteristiques c = { 0 };
+        for (int k = 0; k < repetitions; k++) {
+            Probleme *p = generer_probleme_forme(n, m, e ? 1 : 60, 100, d, arene);
+            if (!p)
+                continue;
+            calculer_caracteristiques(p, &c);
+            for (int h = 0; h < nb_couples; h++) {
+                ResultatTransport res;
+                transport_definir_tarification(ctx, nom_tarification(h % NB_TARIFICATIONS));
+                if (transport_solve(ctx, p, heuristique(h / NB_TARIFICATIONS)->nom, &res) == TRANSPORT_OK)
+                    totaux[h] += res.temps_initial + res.temps_marche_pied;
+                else
+                    totaux[h] += 1e9;
             }
+            vider_arene(arene);
         }
 
-        if (!remplace) {
-            liberer_base(b);
-            b = construire_base(s);
+        int meilleur = 0;
+        printf("%4d x %-4d étendue %.2f déséquilibre %.2f :", n, m, c.etendue, c.desequilibre);
+        for (int h = 0; h < nb_methodes; h++) {
+            int retenu = h * NB_TARIFICATIONS;
+            for (int k = retenu + 1; k < (h + 1) * NB_TARIFICATIONS; k++)
+                if (totaux[k] < totaux[retenu])
+                    retenu = k;
+            printf(" %s %.5f", heuristique(h)->nom, totaux[retenu] / repetitions);
+            if (totaux[retenu] < totaux[meilleur])
+                meilleur = retenu;
         }
+        const char *methode = heuristique(meilleur / NB_TARIFICATIONS)->nom;
+        const char *tarification = nom_tarification(meilleur % NB_TARIFICATIONS);
+        printf(" → %s, %s\n", methode, tarification);
+        fflush(stdout);
+
+        RegleChoix *regle = &regles[nb_regles++];
+        *regle = (RegleChoix){
+            bornes_taille[t], bornes_rapport[r], bornes_etendue[e], SANS_BORNE,
+            bornes_desequilibre[d], 0.5, "", ""
+        };
+        snprintf(regle->methode, sizeof(regle->methode), "%s", methode);
+        snprintf(regle->tarification, sizeof(regle->tarification), "%s", tarification);
     }
 
-    clock_t end = clock();
-
-    liberer_base(b);
-    free(pot_f);
-    free(pot_c);
+    /* Instances creuses : non calibrées ; Balas-Hammer, comme les méthodes
+       gloutonnes, écarte d'emblée les paires interdites que Nord-Ouest
+       emprunte sans les voir, et la tarification par blocs évite de
+       re-parcourir toutes les lignes CSR à chaque pivot */
+    regles[nb_regles++] = (RegleChoix){
+        SANS_BORNE, SANS_BORNE, SANS_BORNE, SANS_BORNE, SANS_BORNE, 0.0, "bh", "blocs"
+    };
+
+    FILE *f = fopen(fichier, "w");
+    if (f) {
+        ecrire_table_choix(f, regles, nb_regles);
+        fclose(f);
+        printf("Table écrite dans %s (transport ... auto --table %s)\n", fichier, fichier);
+    } else {
+        fprintf(stderr, "Impossible d'écrire %s\n", fichier);
+    }
 
-    return (double)(end - start) / CLOCKS_PER_SEC;
+    free(totaux);
+    transport_detruire_contexte(ctx);
+    detruire_arene(arene);
 }
 
 /*
- * Mesure de temps des solutions initiales ----------------------------------
+ * Débit des petits problèmes -------------------------------------------------
  */
 
-double mesurer_temps_nord_ouest(const Probleme *p, Solution **solution_out)
-{
-    if (!p)
-        return -1.0;
-
-    Solution *s = creer_solution_vide(p);
-    if (!s)
-        return -1.0;
-
-    int saved_fd = -1;
-    silence_stdout(&saved_fd);
-
-    clock_t start = clock();
-    coin_nord_ouest(p, s);
-    clock_t end = clock();
+#define NB_PETITS 1024
 
-    restaurer_stdout(saved_fd);
-
-    if (solution_out)
-        *solution_out = s;
-    else
-        liberer_solution(s);
-
-    return (double)(end - start) / CLOCKS_PER_SEC;
+static double horloge(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
 }
 
-double mesurer_temps_balas_hammer(const Probleme *p, Solution **solution_out)
+/* Résolutions par seconde (Nord-Ouest puis marche-pied) sur des petits
+   problèmes aléatoires : chemin rapide seul (petit_probleme.h), puis
+   transport_solve complet (qui l'emprunte aussi). */
+static void lancer_debit_petits(int nb_resolutions)
 {
-    if (!p)
-        return -1.0;
-
-    Solution *s = creer_solution_vide(p);
-    if (!s)
-        return -1.0;
+    static const int formes[][2] = { { 4, 4 }, { 8, 8 }, { 10, 16 }, { 16, 16 } };
+    PetitProbleme *petits = malloc(NB_PETITS * sizeof(PetitProbleme));
+    Probleme **problemes = malloc(NB_PETITS * sizeof(Probleme *));
+    Arene *arene = creer_arene((size_t)1 << 20);
+    ContexteTransport *ctx = transport_creer_contexte();
+    if (!petits || !problemes || !arene || !ctx) {
+        free(petits);
+        free(problemes);
+        detruire_arene(arene);
+        transport_detruire_contexte(ctx);
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return;
+    }
 
-    int saved_fd = -1;
-    silence_stdout(&saved_fd);
+    printf("Petits problèmes : résolutions par seconde (un thread)\n");
+    for (size_t f = 0; f < sizeof(formes) / sizeof(formes[0]); f++) {
+        int n = formes[f][0], m = formes[f][1];
+        for (int k = 0; k < NB_PETITS; k++) {
+            problemes[k] = generer_probleme_forme(n, m, 1, 100, 0, arene);
+            if (!problemes[k] || !charger_petit(problemes[k], &petits[k]))
+                goto fin;
+        }
 
-    clock_t start = clock();
-    balas_hammer(p, s);
-    clock_t end = clock();
+        long long controle = 0;
+        double debut = horloge();
+        for (int r = 0; r < nb_resolutions; r++) {
+            FluxPetit flux;
+            const PetitProbleme *pp = &petits[r % NB_PETITS];
+            nord_ouest_petit(pp, flux);
+            optimiser_petit(pp, flux);
+            controle += cout_petit(pp, flux);
+        }
+        double rapide = nb_resolutions / (horloge() - debut);
 
-    restaurer_stdout(saved_fd);
+        int nb_complets = nb_resolutions / 10;
+        debut = horloge();
+        for (int r = 0; r < nb_complets; r++) {
+            ResultatTransport res;
+            transport_solve(ctx, problemes[r % NB_PETITS], "no", &res);
+        }
+        double complet = nb_complets / (horloge() - debut);
+        vider_arene(arene);
 
-    if (solution_out)
-        *solution_out = s;
-    else
-        liberer_solution(s);
+        printf("%3d x %-3d chemin rapide %10.0f /s   transport_solve %9.0f /s   (contrôle %lld)\n",
+               n, m, rapide, complet, controle);
+    }
 
-    return (double)(end - start) / CLOCKS_PER_SEC;
+fin:
+    free(petits);
+    free(problemes);
+    transport_detruire_contexte(ctx);
+    detruire_arene(arene);
 }
 
 /*
- * Boucle d'expérimentation --------------------------------------------------
+ * Tarification du marche-pied ----------------------------------------------
  */
 
-void lancer_etude_complexite(void)
+/* Pivots et temps par stratégie de tarification (tarification.h) sur des
+   problèmes denses carrés, depuis le Nord-Ouest : chaque stratégie résout
+   la même instance, et doit trouver le même coût optimal. */
+static void lancer_etude_tarification(void)
 {
-    int tailles[] = {10, 40, 100, 200, 400, 1000 };
-    int nb_tailles = (int)(sizeof(tailles) / sizeof(tailles[0]));
-    int repetitions = 100;
-
-    FILE *csv = fopen("resultats_complexite.csv", "w");
-    if (!csv) {
-        fprintf(stderr, "Impossible d'ouvrir resultats_complexite.csv en écriture\n");
+    static const int tailles[] = { 100, 200, 400, 1000 };
+    static const char *const strategies[] = { "dantzig", "blocs", "candidats" };
+    const int nb_strategies = (int)(sizeof(strategies) / sizeof(strategies[0]));
+    Arene *arene = creer_arene((size_t)1 << 20);
+    ContexteTransport *ctx = transport_creer_contexte();
+    if (!arene || !ctx) {
+        detruire_arene(arene);
+        transport_detruire_contexte(ctx);
+        fprintf(stderr, "Mémoire insuffisante\n");
         return;
     }
 
-    fprintf(csv, "n;iteration;theta_no;theta_bh;t_no;t_bh;total_no;total_bh;ratio\n");
-
-    for (int idx = 0; idx < nb_tailles; idx++) {
-        int n = tailles[idx];
-        printf("Taille %d...\n", n);
+    printf("Tarification du marche-pied (Nord-Ouest, coûts 1..100)\n");
+    printf("%6s  %-10s %10s %14s %14s %14s\n",
+           "n", "stratégie", "pivots", "marche-pied", "écoulé", "coût");
+    for (size_t t = 0; t < sizeof(tailles) / sizeof(tailles[0]); t++) {
+        int n = tailles[t];
+        Probleme *p = generer_probleme_forme(n, n, 1, 100, 0, arene);
+        if (!p)
+            break;
 
-        for (int k = 0; k < repetitions; k++) {
-            Probleme *p = generer_probleme_aleatoire(n);
-            if (!p) {
-                fprintf(stderr, "Generation du probleme (%d) impossible\n", n);
-                continue;
+        long long cout_reference = 0;
+        for (int k = 0; k < nb_strategies; k++) {
+            ResultatTransport res;
+            transport_definir_tarification(ctx, strategies[k]);
+            double debut = horloge();
+            if (transport_solve(ctx, p, "no", &res) != TRANSPORT_OK) {
+                fprintf(stderr, "Échec de la résolution %d x %d\n", n, n);
+                goto fin;
             }
-
-            Solution *s_no = NULL;
-            Solution *s_bh = NULL;
-
-            double theta_no = mesurer_temps_nord_ouest(p, &s_no);
-            double theta_bh = mesurer_temps_balas_hammer(p, &s_bh);
-
-            double t_no = (s_no) ? optimiser_par_marche_pied(p, s_no) : -1.0;
-            double t_bh = (s_bh) ? optimiser_par_marche_pied(p, s_bh) : -1.0;
-
-            double total_no = (theta_no >= 0 && t_no >= 0) ? theta_no + t_no : -1.0;
-            double total_bh = (theta_bh >= 0 && t_bh >= 0) ? theta_bh + t_bh : -1.0;
-            double ratio = (total_bh > 0) ? (total_no / total_bh) : 0.0;
-
-            fprintf(csv, "%d;%d;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f\n",
-                    n, k,
-                    theta_no, theta_bh,
-                    t_no, t_bh,
-                    total_no, total_bh,
-                    ratio);
-
-            if (s_no)
-                liberer_solution(s_no);
-            if (s_bh)
-                liberer_solution(s_bh);
-            detruire_probleme(p);
-
-            if ((k + 1) % 10 == 0)
-                printf("  Iteration %d/%d terminee\n", k + 1, repetitions);
+            double ecoule = horloge() - debut;
+
+            if (k == 0)
+                cout_reference = res.cout_total;
+            printf("%6d  %-10s %10d %13.6fs %13.6fs %14lld%s\n",
+                   n, strategies[k], res.nb_iterations - 1, res.temps_marche_pied,
+                   ecoule, res.cout_total,
+                   res.cout_total != cout_reference ? "  (coût différent !)" : "");
+            fflush(stdout);
         }
+        vider_arene(arene);
     }
 
-    fclose(csv);
-    printf("Etude terminee. Resultats dans resultats_complexite.csv\n");
+fin:
+    transport_detruire_contexte(ctx);
+    detruire_arene(arene);
 }
 
-int main(void)
+/* complexite [--tuiles <Kio>] [--threads <n>] : taille des tuiles de lecture
+   des coûts (256 Kio par défaut) et threads de Balas-Hammer comparés au
+   séquentiel (un par cœur par défaut)
+   complexite --calibrer <fichier> : réécrit la table de décision du choix
+   automatique (transport ... auto --table <fichier>)
+   complexite --petits : débit de résolution des petits problèmes
+   complexite --tarification : pivots et temps par stratégie de tarification */
+int main(int argc, char **argv)
 {
+    size_t taille_tuile = 256 * 1024;
+    int nb_threads = nb_coeurs();
+    const char *table = NULL;
+    int petits = 0;
+    int tarification = 0;
+
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--tuiles") == 0 && a + 1 < argc) {
+            taille_tuile = (size_t)strtoul(argv[++a], NULL, 10) * 1024;
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            nb_threads = atoi(argv[++a]);
+            if (nb_threads <= 0)
+                nb_threads = nb_coeurs();
+        } else if (strcmp(argv[a], "--calibrer") == 0 && a + 1 < argc) {
+            table = argv[++a];
+        } else if (strcmp(argv[a], "--petits") == 0) {
+            petits = 1;
+        } else if (strcmp(argv[a], "--tarification") == 0) {
+            tarification = 1;
+        } else {
+            fprintf(stderr, "Usage : %s [--tuiles <Kio>] [--threads <n>]\n"
+                            "        %s --calibrer <fichier>\n"
+                            "        %s --petits\n"
+                            "        %s --tarification\n", argv[0], argv[0], argv[0], argv[0]);
+            return 1;
+        }
+    }
+
     srand((unsigned int)time(NULL));
-    lancer_etude_complexite();
+    if (tarification)
+        lancer_etude_tarification();
+    else if (petits)
+        lancer_debit_petits(20000);
+    else if (table)
+        lancer_calibration(table, 3);
+    else
+        lancer_etude_complexite(taille_tuile, nb_threads);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "cout_minimal.h"
+#include "couts.h"
+#include "tas.h"
+#include "trace.h"
+#include "annulation.h"
+
+static int minimum(int a, int b) { return (a < b) ? a : b; }
+
+/*
+ * Chaque ligne active est rangée dans un tas par le coût de sa colonne
+ * active la moins chère (à égalité, la plus petite ligne ; dans la ligne, la
+ * plus petite colonne) : le sommet donne la case minimale de la matrice.
+ * Rayer une colonne ne touche pas au tas ; une ligne dont la colonne retenue
+ * a été rayée n'est recalculée qu'en arrivant au sommet. Sa clé ne peut
+ * qu'augmenter (minimum sur moins de colonnes), donc une clé périmée reste
+ * un minorant et le sommet, une fois à jour, est bien la case minimale.
+ *
+ * Les recalculs de ligne passent par les noyaux vectoriels de couts.h :
+ * mesuré, c'est bien plus rapide que de trier d'abord les coûts (index_couts.h),
+ * car peu de lignes sont recalculées avant d'être rayées.
+ */
+
+void cout_minimal(const Probleme *p, Solution *s)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    int *provisions = malloc((size_t)n * sizeof(int));
+    int *commandes = malloc((size_t)m * sizeof(int));
+    int *colonne_active = malloc((size_t)m * sizeof(int));
+    int *colonne_min = malloc((size_t)n * sizeof(int));     // colonne retenue de chaque ligne
+    int *tampon = malloc((size_t)taille_tampon_couts(p) * sizeof(int));
+    Tas file = { 0 };
+
+    if (!provisions || !commandes || !colonne_active || !colonne_min ||
+        !tampon || initialiser_tas(&file, n) != 0) {
+        trace("Erreur coût minimal : mémoire insuffisante.\n");
+        goto fin;
+    }
+
+    trace("\n--- Déroulé de la méthode du coût minimal ---\n\n");
+
+    for (int j = 0; j < m; j++) {
+        commandes[j] = p->commandes[j];
+        colonne_active[j] = (commandes[j] > 0);
+    }
+
+    for (int i = 0; i < n; i++) {
+        provisions[i] = p->provisions[i];
+        if (provisions[i] <= 0)
+            continue;
+        long long c;
+        colonne_min[i] = argmin_ligne_actif(p, i, colonne_active, tampon, &c);
+        if (colonne_min[i] >= 0)
+            tas_placer(&file, i, c);
+    }
+
+    while (!tas_vide(&file) && !methode_annulee()) {
+        int i = tas_sommet(&file);
+
+        if (!colonne_active[colonne_min[i]]) {
+            long long c;
+            colonne_min[i] = argmin_ligne_actif(p, i, colonne_active, tampon, &c);
+            if (colonne_min[i] < 0)
+                tas_retirer(&file, i);
+            else
+                tas_placer(&file, i, c);
+            continue;
+        }
+
+        int j = colonne_min[i];
+        int q = minimum(provisions[i], commandes[j]);
+        sol_fixer(s, i, j, q);
+
+        trace("Remplissage de la case (%d,%d) avec %d unités (coût %lld)\n",
+               i, j, q, file.cle[i]);
+
+        provisions[i] -= q;
+        commandes[j] -= q;
+
+        // Une quantité épuisée raye sa ligne ou sa colonne (les deux à égalité)
+        if (provisions[i] == 0)
+            tas_retirer(&file, i);
+        if (commandes[j] == 0)
+            colonne_active[j] = 0;
+    }
+
+    trace("\n--- Fin de la méthode du coût minimal ---\n\n");
+
+fin:
+    free(provisions);
+    free(commandes);
+    free(colonne_active);
+    free(colonne_min);
+    free(tampon);
+    liberer_tas(&file);
+}
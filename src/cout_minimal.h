@@ -0,0 +1,10 @@
+#ifndef COUT_MINIMAL_H
+#define COUT_MINIMAL_H
+
+#include "problem.h"
+
+// Proposition initiale par la méthode du coût minimal : remplit à chaque
+// étape la case active la moins chère de toute la matrice
+void cout_minimal(const Probleme *p, Solution *s);
+
+#endif
@@ -0,0 +1,469 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "couts.h"
+#include "couts_simd.h"
+#include "utils.h"
+#include "arene.h"
+
+/*
+ * Noyaux de distance -------------------------------------------------------
+ *
+ * Les coordonnées sont rangées en structure de tableaux (x et y séparés) :
+ * chaque boucle est une suite d'opérations indépendantes sur des tableaux
+ * contigus, que le compilateur vectorise (sqrt compris avec -fno-math-errno).
+ * Recalculer une ligne revient alors moins cher que de la relire en mémoire.
+ */
+
+static void distances_vers(int metrique, double x, double y,
+                           const double *restrict xs, const double *restrict ys,
+                           int nb, int *restrict dest)
+{
+    switch (metrique) {
+    case METRIQUE_L1:
+        for (int k = 0; k < nb; k++)
+            dest[k] = (int)(fabs(x - xs[k]) + fabs(y - ys[k]));
+        break;
+    case METRIQUE_L2:
+        for (int k = 0; k < nb; k++) {
+            double dx = x - xs[k], dy = y - ys[k];
+            dest[k] = (int)sqrt(dx * dx + dy * dy);
+        }
+        break;
+    default: /* METRIQUE_L2_ARRONDI */
+        for (int k = 0; k < nb; k++) {
+            double dx = x - xs[k], dy = y - ys[k];
+            dest[k] = (int)(sqrt(dx * dx + dy * dy) + 0.5);
+        }
+        break;
+    }
+}
+
+int cout_implicite(const Probleme *p, int i, int j)
+{
+    int c;
+    distances_vers(p->metrique, p->x_f[i], p->y_f[i], &p->x_c[j], &p->y_c[j], 1, &c);
+    return c;
+}
+
+/*
+ * Noyaux par largeur ---------------------------------------------------------
+ *
+ * Un jeu de noyaux par type de stockage (int16 / int32 / int64), généré par
+ * macro. Les lignes se lisent avec pas = 1 (boucle contiguë), les colonnes
+ * avec pas = pas_couts. Les valeurs sont comparées et renvoyées sur 64 bits.
+ * La sentinelle "pas de valeur" reste INT_MAX pour 16 et 32 bits, comme dans
+ * la version historique sur int.
+ */
+
+#define DEFINIR_NOYAUX(SUF, T, SENTINELLE)                                          \
+static inline void deux_minima_##SUF(const void *base, size_t pas, int nb,          \
+                                     const int *actif, DeuxMinima *r)               \
+{                                                                                   \
+    const T *v = base;                                                              \
+    long long m1 = SENTINELLE, m2 = SENTINELLE;                                     \
+    int a1 = -1, a2 = -1;                                                           \
+    for (int k = 0; k < nb; k++) {                                                  \
+        if (!actif[k]) continue;                                                    \
+        long long c = v[(size_t)k * pas];                                           \
+        if (c < m1) { m2 = m1; a2 = a1; m1 = c; a1 = k; }                           \
+        else if (c < m2) { m2 = c; a2 = k; }                                        \
+    }                                                                               \
+    r->min1 = m1; r->arg1 = a1;                                                     \
+    r->min2 = m2; r->arg2 = a2;                                                     \
+}                                                                                   \
+                                                                                    \
+static inline int argmin_actif_##SUF(const void *base, size_t pas, int nb,          \
+                                     const int *actif, long long *cout_min)         \
+{                                                                                   \
+    const T *v = base;                                                              \
+    long long meilleur = SENTINELLE;                                                \
+    int indice = -1;                                                                \
+    for (int k = 0; k < nb; k++) {                                                  \
+        if (!actif[k]) continue;                                                    \
+        long long c = v[(size_t)k * pas];                                           \
+        if (c < meilleur) { meilleur = c; indice = k; }                             \
+    }                                                                               \
+    *cout_min = meilleur;                                                           \
+    return indice;                                                                  \
+}                                                                                   \
+                                                                                    \
+static inline int marginal_min_##SUF(const void *base, int nb, int i, long long u_i,\
+                                     const long long *pot_c, long long *meilleur,   \
+                                     ExclusionCase exclure, const void *ctx)        \
+{                                                                                   \
+    const T *v = base;                                                              \
+    long long seuil = *meilleur;                                                    \
+    int indice = -1;                                                                \
+    for (int j = 0; j < nb; j++) {                                                  \
+        long long marginal = (long long)v[j] - (u_i - pot_c[j]);                    \
+        if (marginal < seuil && !(exclure && exclure(ctx, i, j))) {                 \
+            seuil = marginal;                                                       \
+            indice = j;                                                             \
+        }                                                                           \
+    }                                                                               \
+    *meilleur = seuil;                                                              \
+    return indice;                                                                  \
+}                                                                                   \
+                                                                                    \
+static inline void minima_colonnes_##SUF(const void *base, int nb, int i,           \
+                                         DeuxMinima *restrict col)                  \
+{                                                                                   \
+    const T *v = base;                                                              \
+    for (int j = 0; j < nb; j++) {                                                  \
+        long long c = v[j];                                                         \
+        DeuxMinima *d = &col[j];                                                    \
+        if (c < d->min1) {                                                          \
+            d->min2 = d->min1; d->arg2 = d->arg1;                                   \
+            d->min1 = c; d->arg1 = i;                                               \
+        } else if (c < d->min2) {                                                   \
+            d->min2 = c; d->arg2 = i;                                               \
+        }                                                                           \
+    }                                                                               \
+}
+
+DEFINIR_NOYAUX(16, int16_t, INT_MAX)
+DEFINIR_NOYAUX(32, int32_t, INT_MAX)
+DEFINIR_NOYAUX(64, int64_t, LLONG_MAX)
+
+// Appelle le noyau NOM correspondant à la largeur stockée
+#define SELON_LARGEUR(p, NOM, ...)                                                  \
+    ((p)->largeur_couts == 2 ? NOM##_16(__VA_ARGS__) :                              \
+     (p)->largeur_couts == 8 ? NOM##_64(__VA_ARGS__) : NOM##_32(__VA_ARGS__))
+
+// Début de la colonne j (lecture avec pas = pas_couts)
+static inline const void *colonne_couts(const Probleme *p, int j)
+{
+    return (const char *)p->couts + (size_t)j * p->largeur_couts;
+}
+
+/*
+ * Points d'entrée ----------------------------------------------------------------
+ */
+
+int taille_tampon_couts(const Probleme *p)
+{
+    return (p->nb_fournisseurs > p->nb_clients) ? p->nb_fournisseurs : p->nb_clients;
+}
+
+// Variante implicite : la ligne i (ou la colonne j, la distance étant symétrique)
+// est recalculée dans tampon, puis traitée par les noyaux 32 bits.
+static const int *ligne_implicite(const Probleme *p, int i, int *tampon)
+{
+    distances_vers(p->metrique, p->x_f[i], p->y_f[i],
+                   p->x_c, p->y_c, p->nb_clients, tampon);
+    return tampon;
+}
+
+static const int *colonne_implicite(const Probleme *p, int j, int *tampon)
+{
+    distances_vers(p->metrique, p->x_c[j], p->y_c[j],
+                   p->x_f, p->y_f, p->nb_fournisseurs, tampon);
+    return tampon;
+}
+
+/*
+ * Les lignes sont contiguës : noyaux AVX2 (couts_simd.c) quand le processeur
+ * les supporte, pour les coûts 16 et 32 bits (et 64 bits en tarification).
+ * Les colonnes, lues avec un pas, restent scalaires ; pour les lire aussi en
+ * vectoriel, on passe par une copie transposée (transposer_probleme).
+ */
+
+void deux_minima_ligne(const Probleme *p, int i, const int *actif, int *tampon,
+                       DeuxMinima *r)
+{
+    if (!p->couts) {
+        const int *ligne = ligne_implicite(p, i, tampon);
+#if COUTS_SIMD
+        if (simd_disponible()) {
+            deux_minima_avx2_32(ligne, p->nb_clients, actif, r);
+            return;
+        }
+#endif
+        deux_minima_32(ligne, 1, p->nb_clients, actif, r);
+        return;
+    }
+#if COUTS_SIMD
+    if (simd_disponible() && p->largeur_couts != 8) {
+        if (p->largeur_couts == 2)
+            deux_minima_avx2_16(ligne_couts(p, i), p->nb_clients, actif, r);
+        else
+            deux_minima_avx2_32(ligne_couts(p, i), p->nb_clients, actif, r);
+        return;
+    }
+#endif
+    SELON_LARGEUR(p, deux_minima, ligne_couts(p, i), 1, p->nb_clients, actif, r);
+}
+
+void deux_minima_colonne(const Probleme *p, int j, const int *actif, int *tampon,
+                         DeuxMinima *r)
+{
+    if (!p->couts)
+        deux_minima_32(colonne_implicite(p, j, tampon), 1, p->nb_fournisseurs, actif, r);
+    else
+        SELON_LARGEUR(p, deux_minima, colonne_couts(p, j), (size_t)p->pas_couts,
+                      p->nb_fournisseurs, actif, r);
+}
+
+/*
+ * Variante creuse : les arcs autorisés d'une ligne (ou colonne) sont triés
+ * par position ; toute autre position active coûte cout_interdit. Le plus
+ * petit coût suit le même ordre (coût, position) que les noyaux denses.
+ */
+
+// Première position active qui n'est pas un arc autorisé, -1 sinon
+static int premier_actif_hors_arcs(const int *positions, int nb_arcs, int nb, const int *actif)
+{
+    int a = 0;
+    for (int x = 0; x < nb; x++) {
+        while (a < nb_arcs && positions[a] < x)
+            a++;
+        if (a < nb_arcs && positions[a] == x)
+            continue;
+        if (actif[x])
+            return x;
+    }
+    return -1;
+}
+
+// arcs[k] : indice de l'arc de rang k (NULL : arcs contigus à partir de base)
+static int argmin_actif_creux(const Probleme *p, const int *positions, const int *arcs,
+                              int base, int nb_arcs, int nb, const int *actif,
+                              long long *cout_min)
+{
+    long long meilleur = LLONG_MAX;
+    int indice = -1;
+
+    for (int k = 0; k < nb_arcs; k++) {
+        int x = positions[k];
+        long long c = p->arc_cout[arcs ? arcs[k] : base + k];
+        if (actif[x] && c < meilleur) {
+            meilleur = c;
+            indice = x;
+        }
+    }
+    if (p->cout_interdit <= meilleur) {
+        int x = premier_actif_hors_arcs(positions, nb_arcs, nb, actif);
+        if (x >= 0 && (p->cout_interdit < meilleur || x < indice)) {
+            meilleur = p->cout_interdit;
+            indice = x;
+        }
+    }
+    *cout_min = meilleur;
+    return indice;
+}
+
+int argmin_ligne_actif(const Probleme *p, int i, const int *actif, int *tampon,
+                       long long *cout_min)
+{
+    if (est_creux(p)) {
+        int debut = p->debut_ligne[i];
+        return argmin_actif_creux(p, p->arc_client + debut, NULL, debut,
+                                  p->debut_ligne[i + 1] - debut, p->nb_clients, actif, cout_min);
+    }
+    if (!p->couts) {
+        const int *ligne = ligne_implicite(p, i, tampon);
+#if COUTS_SIMD
+        if (simd_disponible())
+            return argmin_actif_avx2_32(ligne, p->nb_clients, actif, cout_min);
+#endif
+        return argmin_actif_32(ligne, 1, p->nb_clients, actif, cout_min);
+    }
+#if COUTS_SIMD
+    if (simd_disponible() && p->largeur_couts != 8)
+        return (p->largeur_couts == 2)
+             ? argmin_actif_avx2_16(ligne_couts(p, i), p->nb_clients, actif, cout_min)
+             : argmin_actif_avx2_32(ligne_couts(p, i), p->nb_clients, actif, cout_min);
+#endif
+    return SELON_LARGEUR(p, argmin_actif, ligne_couts(p, i), 1, p->nb_clients, actif, cout_min);
+}
+
+int argmin_colonne_actif(const Probleme *p, int j, const int *actif, int *tampon,
+                         long long *cout_min)
+{
+    if (est_creux(p)) {
+        int debut = p->debut_colonne[j];
+        return argmin_actif_creux(p, p->fournisseur_par_colonne + debut,
+                                  p->arc_par_colonne + debut, 0,
+                                  p->debut_colonne[j + 1] - debut, p->nb_fournisseurs,
+                                  actif, cout_min);
+    }
+    if (!p->couts)
+        return argmin_actif_32(colonne_implicite(p, j, tampon), 1, p->nb_fournisseurs,
+                               actif, cout_min);
+    return SELON_LARGEUR(p, argmin_actif, colonne_couts(p, j), (size_t)p->pas_couts,
+                         p->nb_fournisseurs, actif, cout_min);
+}
+
+int marginal_min_ligne(const Probleme *p, int i, long long u_i, const long long *pot_c,
+                       int *tampon, long long *meilleur,
+                       ExclusionCase exclure, const void *ctx)
+{
+    if (!p->couts) {
+        const int *ligne = ligne_implicite(p, i, tampon);
+#if COUTS_SIMD
+        if (simd_disponible())
+            return marginal_min_avx2_32(ligne, p->nb_clients, i, u_i,
+                                        pot_c, meilleur, exclure, ctx);
+#endif
+        return marginal_min_32(ligne, p->nb_clients, i, u_i, pot_c, meilleur, exclure, ctx);
+    }
+#if COUTS_SIMD
+    if (simd_disponible())
+        return SELON_LARGEUR(p, marginal_min_avx2, ligne_couts(p, i), p->nb_clients, i, u_i,
+                             pot_c, meilleur, exclure, ctx);
+#endif
+    return SELON_LARGEUR(p, marginal_min, ligne_couts(p, i), p->nb_clients, i, u_i,
+                         pot_c, meilleur, exclure, ctx);
+}
+
+void copier_ligne_couts(const Probleme *p, int i, int *tampon, long long *dest)
+{
+    if (est_creux(p)) {
+        for (int j = 0; j < p->nb_clients; j++)
+            dest[j] = p->cout_interdit;
+        for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++)
+            dest[p->arc_client[k]] = p->arc_cout[k];
+        return;
+    }
+    if (!p->couts) {
+        const int *ligne = ligne_implicite(p, i, tampon);
+        for (int j = 0; j < p->nb_clients; j++)
+            dest[j] = ligne[j];
+        return;
+    }
+    for (int j = 0; j < p->nb_clients; j++)
+        dest[j] = cout_dense(p, i, j);
+}
+
+void copier_colonne_couts(const Probleme *p, int j, int *tampon, long long *dest)
+{
+    if (est_creux(p)) {
+        for (int i = 0; i < p->nb_fournisseurs; i++)
+            dest[i] = p->cout_interdit;
+        for (int k = p->debut_colonne[j]; k < p->debut_colonne[j + 1]; k++)
+            dest[p->fournisseur_par_colonne[k]] = p->arc_cout[p->arc_par_colonne[k]];
+        return;
+    }
+    if (!p->couts) {
+        const int *colonne = colonne_implicite(p, j, tampon);
+        for (int i = 0; i < p->nb_fournisseurs; i++)
+            dest[i] = colonne[i];
+        return;
+    }
+    for (int i = 0; i < p->nb_fournisseurs; i++)
+        dest[i] = cout_dense(p, i, j);
+}
+
+#define TRANSPOSER(T, t, p)                                                         \
+    for (int ib = 0; ib < (p)->nb_fournisseurs; ib += 64)                           \
+        for (int jb = 0; jb < (p)->nb_clients; jb += 64)                            \
+            for (int i = ib; i < ib + 64 && i < (p)->nb_fournisseurs; i++) {        \
+                const T *ligne = ligne_couts(p, i);                                 \
+                for (int j = jb; j < jb + 64 && j < (p)->nb_clients; j++)           \
+                    ((T *)ligne_couts(t, j))[i] = ligne[j];                         \
+            }
+
+Probleme *transposer_probleme(const Probleme *p)
+{
+    if (!p->couts)
+        return NULL;
+
+    Probleme *t = creer_probleme_largeur(p->nb_clients, p->nb_fournisseurs, p->largeur_couts);
+    if (!t)
+        return NULL;
+
+    memcpy(t->provisions, p->commandes, (size_t)p->nb_clients * sizeof(int));
+    memcpy(t->commandes, p->provisions, (size_t)p->nb_fournisseurs * sizeof(int));
+
+    // Par blocs de 64 x 64 : lecture et écriture restent dans le cache
+    switch (p->largeur_couts) {
+    case 2:  TRANSPOSER(int16_t, t, p); break;
+    case 8:  TRANSPOSER(int64_t, t, p); break;
+    default: TRANSPOSER(int32_t, t, p); break;
+    }
+    return t;
+}
+
+long long sentinelle_couts(const Probleme *p)
+{
+    // Creux : cout_interdit peut dépasser INT_MAX
+    if (est_creux(p) || (p->couts && p->largeur_couts == 8))
+        return LLONG_MAX;
+    return INT_MAX;
+}
+
+void debut_minima_colonnes(const Probleme *p, DeuxMinima *col)
+{
+    long long sentinelle = sentinelle_couts(p);
+    for (int j = 0; j < p->nb_clients; j++) {
+        col[j].min1 = col[j].min2 = sentinelle;
+        col[j].arg1 = col[j].arg2 = -1;
+    }
+}
+
+void accumuler_minima_colonnes(const Probleme *p, int i, int *tampon, DeuxMinima *col)
+{
+    if (!p->couts)
+        minima_colonnes_32(ligne_implicite(p, i, tampon), p->nb_clients, i, col);
+    else
+        SELON_LARGEUR(p, minima_colonnes, ligne_couts(p, i), p->nb_clients, i, col);
+}
+
+/*
+ * Choix de la largeur de stockage -----------------------------------------------
+ */
+
+int adapter_largeur_couts(Probleme *p)
+{
+    // Rien à faire hors matrice dense ; une projection binaire garde sa largeur
+    if (!p->couts || p->projection)
+        return p->largeur_couts;
+
+    long long cmin = LLONG_MAX, cmax = LLONG_MIN;
+    for (int i = 0; i < p->nb_fournisseurs; i++) {
+        for (int j = 0; j < p->nb_clients; j++) {
+            long long c = cout_dense(p, i, j);
+            if (c < cmin) cmin = c;
+            if (c > cmax) cmax = c;
+        }
+    }
+
+    int largeur = 8;
+    if (cmin >= INT16_MIN && cmax <= INT16_MAX)
+        largeur = 2;
+    else if (cmin >= INT32_MIN && cmax <= INT32_MAX)
+        largeur = 4;
+
+    if (largeur == p->largeur_couts)
+        return largeur;
+
+    int pas = pas_aligne(p->nb_clients, (size_t)largeur);
+    void *bloc;
+    if (p->arene) {
+        size_t taille = (size_t)p->nb_fournisseurs * pas * largeur;
+        bloc = arene_alloc_aligne(p->arene, taille, ALIGNEMENT_MATRICE);
+        if (bloc)
+            memset(bloc, 0, taille);
+    } else {
+        bloc = allouer_bloc_aligne((size_t)p->nb_fournisseurs, (size_t)pas, (size_t)largeur);
+    }
+    if (!bloc)
+        return p->largeur_couts;   // on garde la largeur actuelle
+
+    Probleme cible = *p;
+    cible.couts = bloc;
+    cible.largeur_couts = largeur;
+    cible.pas_couts = pas;
+    for (int i = 0; i < p->nb_fournisseurs; i++)
+        for (int j = 0; j < p->nb_clients; j++)
+            fixer_cout(&cible, i, j, cout_dense(p, i, j));
+
+    if (!p->arene)   // dans une arène, l'ancienne matrice part au vidage
+        liberer_bloc_aligne(p->couts);
+    p->couts = bloc;
+    p->largeur_couts = largeur;
+    p->pas_couts = pas;
+    return largeur;
+}
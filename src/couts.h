@@ -0,0 +1,77 @@
+#ifndef COUTS_H
+#define COUTS_H
+
+#include "problem.h"
+
+/*
+ * Noyaux de calcul sur les lignes / colonnes de coûts, quelle que soit la
+ * représentation (matrice dense de largeur 2, 4 ou 8 octets, ou coûts
+ * implicites). La variante creuse se parcourt directement par ses arcs
+ * (debut_ligne / debut_colonne).
+ *
+ * tampon doit pouvoir contenir taille_tampon_couts(p) entiers ; il ne sert
+ * qu'à recalculer une ligne ou une colonne en variante implicite.
+ */
+
+int taille_tampon_couts(const Probleme *p);
+
+// Deux plus petits coûts d'une ligne ou d'une colonne et leurs positions
+// (première occurrence en cas d'égalité). Sans valeur, min vaut
+// sentinelle_couts(p) et arg vaut -1.
+typedef struct {
+    long long min1, min2;
+    int arg1, arg2;
+} DeuxMinima;
+
+// Coût "absent" des minima : INT_MAX, ou LLONG_MAX pour des coûts sur 64 bits
+// et en variante creuse (cout_interdit sur 64 bits)
+long long sentinelle_couts(const Probleme *p);
+
+// Deux plus petits coûts de la ligne i parmi les colonnes actives (actif[j] != 0),
+// ou de la colonne j parmi les lignes actives (pénalités de Balas-Hammer)
+void deux_minima_ligne(const Probleme *p, int i, const int *actif, int *tampon,
+                       DeuxMinima *r);
+void deux_minima_colonne(const Probleme *p, int j, const int *actif, int *tampon,
+                         DeuxMinima *r);
+
+// Deux plus petits coûts de toutes les colonnes, en parcourant la matrice
+// ligne par ligne (lecture contiguë, compatible avec la lecture par tuiles) :
+// debut_minima_colonnes initialise col (taille nb_clients), puis
+// accumuler_minima_colonnes y intègre la ligne i.
+void debut_minima_colonnes(const Probleme *p, DeuxMinima *col);
+void accumuler_minima_colonnes(const Probleme *p, int i, int *tampon, DeuxMinima *col);
+
+// Case la moins chère de la ligne i parmi les colonnes actives (actif[j] != 0),
+// ou de la colonne j parmi les lignes actives. Renvoie l'indice trouvé (-1 sinon)
+// et son coût dans *cout_min. Accepte aussi la variante creuse, où toute
+// case hors arcs coûte cout_interdit.
+int argmin_ligne_actif(const Probleme *p, int i, const int *actif, int *tampon,
+                       long long *cout_min);
+int argmin_colonne_actif(const Probleme *p, int j, const int *actif, int *tampon,
+                         long long *cout_min);
+
+// Copie la ligne i (ou la colonne j) de coûts dans dest, sur 64 bits
+// (toutes représentations, cout_interdit hors arcs en variante creuse)
+void copier_ligne_couts(const Probleme *p, int i, int *tampon, long long *dest);
+void copier_colonne_couts(const Probleme *p, int j, int *tampon, long long *dest);
+
+// Copie transposée d'une matrice dense (les colonnes de p sont les lignes de
+// la copie, même largeur) : les noyaux de ligne, vectorisés, s'appliquent
+// alors aux colonnes. NULL hors matrice dense ; libérer par liberer_probleme().
+Probleme *transposer_probleme(const Probleme *p);
+
+// Filtre facultatif de la tarification : renvoie 1 pour écarter la case (i,j)
+typedef int (*ExclusionCase)(const void *ctx, int i, int j);
+
+// Tarification d'une ligne : plus petit coût marginal a_ij - (u_i - v_j)
+// strictement inférieur à *meilleur parmi les cases non exclues.
+// Met *meilleur à jour et renvoie la colonne retenue, ou -1.
+int marginal_min_ligne(const Probleme *p, int i, long long u_i, const long long *pot_c,
+                       int *tampon, long long *meilleur,
+                       ExclusionCase exclure, const void *ctx);
+
+// Choisit la plus petite largeur (16, 32 ou 64 bits) contenant tous les coûts
+// de la matrice dense et la réalloue à cette largeur. Renvoie la largeur en octets.
+int adapter_largeur_couts(Probleme *p);
+
+#endif
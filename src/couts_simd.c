@@ -0,0 +1,245 @@
+#include <limits.h>
+#include "couts_simd.h"
+
+#if COUTS_SIMD
+
+#include <immintrin.h>
+
+/*
+ * Chaque voie d'un registre de 8 entiers 32 bits tient ses propres minima,
+ * en parcourant ses positions dans l'ordre (comparaison stricte : première
+ * occurrence). Les 8 voies sont ensuite fusionnées selon l'ordre (coût,
+ * indice), puis la fin de ligne est traitée en scalaire. Les coûts 16 bits
+ * sont étendus à 32 bits au chargement ; une case inactive prend la valeur
+ * sentinelle INT_MAX, qui n'est jamais retenue.
+ *
+ * Tarification : les coûts marginaux sont calculés 8 par 8 sur 64 bits ;
+ * seul un bloc contenant une valeur sous le seuil courant repasse en
+ * scalaire (filtre d'exclusion compris), dans l'ordre des colonnes.
+ */
+
+#define AVX2 __attribute__((target("avx2")))
+
+int simd_disponible(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+// Insère la candidate (c, k) dans r selon l'ordre (coût, indice)
+static void inserer(DeuxMinima *r, long long c, int k)
+{
+    if (k < 0)
+        return;
+    if (c < r->min1 || (c == r->min1 && k < r->arg1)) {
+        r->min2 = r->min1; r->arg2 = r->arg1;
+        r->min1 = c;       r->arg1 = k;
+    } else if (c < r->min2 || (c == r->min2 && k < r->arg2)) {
+        r->min2 = c;       r->arg2 = k;
+    }
+}
+
+AVX2 static inline __m256i charger_8x16(const int16_t *v)
+{
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)v));
+}
+
+AVX2 static inline __m256i charger_8x32(const int32_t *v)
+{
+    return _mm256_loadu_si256((const __m256i *)v);
+}
+
+AVX2 static inline __m256i masquer_inactifs(__m256i c, const int *actif)
+{
+    __m256i act = _mm256_loadu_si256((const __m256i *)actif);
+    __m256i inactif = _mm256_cmpeq_epi32(act, _mm256_setzero_si256());
+    return _mm256_blendv_epi8(c, _mm256_set1_epi32(INT_MAX), inactif);
+}
+
+/*
+ * Deux minima --------------------------------------------------------------------
+ */
+
+typedef struct {
+    __m256i m1, a1, m2, a2;
+} VoiesDeuxMinima;
+
+AVX2 static inline void debut_voies(VoiesDeuxMinima *w)
+{
+    w->m1 = w->m2 = _mm256_set1_epi32(INT_MAX);
+    w->a1 = w->a2 = _mm256_set1_epi32(-1);
+}
+
+AVX2 static inline void etape_voies(VoiesDeuxMinima *w, __m256i c, __m256i idx)
+{
+    __m256i lt1 = _mm256_cmpgt_epi32(w->m1, c);
+    __m256i lt2 = _mm256_cmpgt_epi32(w->m2, c);
+    w->m2 = _mm256_blendv_epi8(_mm256_blendv_epi8(w->m2, c, lt2), w->m1, lt1);
+    w->a2 = _mm256_blendv_epi8(_mm256_blendv_epi8(w->a2, idx, lt2), w->a1, lt1);
+    w->m1 = _mm256_blendv_epi8(w->m1, c, lt1);
+    w->a1 = _mm256_blendv_epi8(w->a1, idx, lt1);
+}
+
+AVX2 static void conclure_voies(const VoiesDeuxMinima *w, DeuxMinima *r)
+{
+    int32_t m1[8], a1[8], m2[8], a2[8];
+    _mm256_storeu_si256((__m256i *)m1, w->m1);
+    _mm256_storeu_si256((__m256i *)a1, w->a1);
+    _mm256_storeu_si256((__m256i *)m2, w->m2);
+    _mm256_storeu_si256((__m256i *)a2, w->a2);
+
+    r->min1 = r->min2 = INT_MAX;
+    r->arg1 = r->arg2 = -1;
+    for (int l = 0; l < 8; l++) {
+        inserer(r, m1[l], a1[l]);
+        inserer(r, m2[l], a2[l]);
+    }
+}
+
+// Fin de ligne : positions plus grandes que toutes les précédentes
+#define QUEUE_DEUX_MINIMA(v, k, nb, actif, r)                                       \
+    for (; (k) < (nb); (k)++) {                                                     \
+        if (!(actif)[k]) continue;                                                  \
+        long long c = (v)[k];                                                       \
+        if (c < (r)->min1) {                                                        \
+            (r)->min2 = (r)->min1; (r)->arg2 = (r)->arg1;                           \
+            (r)->min1 = c;         (r)->arg1 = (k);                                 \
+        } else if (c < (r)->min2) {                                                 \
+            (r)->min2 = c;         (r)->arg2 = (k);                                 \
+        }                                                                           \
+    }
+
+#define DEFINIR_DEUX_MINIMA(SUF, T)                                                 \
+AVX2 void deux_minima_avx2_##SUF(const T *v, int nb, const int *actif, DeuxMinima *r)\
+{                                                                                   \
+    VoiesDeuxMinima w;                                                              \
+    debut_voies(&w);                                                                \
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);                        \
+    const __m256i huit = _mm256_set1_epi32(8);                                      \
+    int k = 0;                                                                      \
+    for (; k + 8 <= nb; k += 8) {                                                   \
+        __m256i c = masquer_inactifs(charger_8x##SUF(v + k), actif + k);            \
+        etape_voies(&w, c, idx);                                                    \
+        idx = _mm256_add_epi32(idx, huit);                                          \
+    }                                                                               \
+    conclure_voies(&w, r);                                                          \
+    QUEUE_DEUX_MINIMA(v, k, nb, actif, r)                                           \
+}
+
+DEFINIR_DEUX_MINIMA(16, int16_t)
+DEFINIR_DEUX_MINIMA(32, int32_t)
+
+/*
+ * Plus petit coût actif -----------------------------------------------------------
+ */
+
+#define DEFINIR_ARGMIN(SUF, T)                                                      \
+AVX2 int argmin_actif_avx2_##SUF(const T *v, int nb, const int *actif,              \
+                                 long long *cout_min)                               \
+{                                                                                   \
+    __m256i m = _mm256_set1_epi32(INT_MAX);                                         \
+    __m256i a = _mm256_set1_epi32(-1);                                              \
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);                        \
+    const __m256i huit = _mm256_set1_epi32(8);                                      \
+    int k = 0;                                                                      \
+    for (; k + 8 <= nb; k += 8) {                                                   \
+        __m256i c = masquer_inactifs(charger_8x##SUF(v + k), actif + k);            \
+        __m256i lt = _mm256_cmpgt_epi32(m, c);                                      \
+        m = _mm256_blendv_epi8(m, c, lt);                                           \
+        a = _mm256_blendv_epi8(a, idx, lt);                                         \
+        idx = _mm256_add_epi32(idx, huit);                                          \
+    }                                                                               \
+                                                                                    \
+    int32_t vm[8], va[8];                                                           \
+    _mm256_storeu_si256((__m256i *)vm, m);                                          \
+    _mm256_storeu_si256((__m256i *)va, a);                                          \
+    long long meilleur = INT_MAX;                                                   \
+    int indice = -1;                                                                \
+    for (int l = 0; l < 8; l++) {                                                   \
+        if (va[l] < 0) continue;                                                    \
+        if (vm[l] < meilleur || (vm[l] == meilleur && va[l] < indice)) {            \
+            meilleur = vm[l];                                                       \
+            indice = va[l];                                                         \
+        }                                                                           \
+    }                                                                               \
+    for (; k < nb; k++) {                                                           \
+        if (!actif[k]) continue;                                                    \
+        if (v[k] < meilleur) { meilleur = v[k]; indice = k; }                       \
+    }                                                                               \
+    *cout_min = meilleur;                                                           \
+    return indice;                                                                  \
+}
+
+DEFINIR_ARGMIN(16, int16_t)
+DEFINIR_ARGMIN(32, int32_t)
+
+/*
+ * Tarification ---------------------------------------------------------------------
+ */
+
+AVX2 static inline __m256i charger_4x16(const int16_t *v)
+{
+    return _mm256_cvtepi16_epi64(_mm_loadl_epi64((const __m128i *)v));
+}
+
+AVX2 static inline __m256i charger_4x32(const int32_t *v)
+{
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)v));
+}
+
+AVX2 static inline __m256i charger_4x64(const int64_t *v)
+{
+    return _mm256_loadu_si256((const __m256i *)v);
+}
+
+#define DEFINIR_MARGINAL(SUF, T)                                                    \
+AVX2 int marginal_min_avx2_##SUF(const T *v, int nb, int i, long long u_i,          \
+                                 const long long *pot_c, long long *meilleur,       \
+                                 ExclusionCase exclure, const void *ctx)            \
+{                                                                                   \
+    long long seuil = *meilleur;                                                    \
+    int indice = -1;                                                                \
+    const __m256i u = _mm256_set1_epi64x(u_i);                                      \
+    __m256i s = _mm256_set1_epi64x(seuil);                                          \
+    int j = 0;                                                                      \
+    for (; j + 8 <= nb; j += 8) {                                                   \
+        __m256i c0 = _mm256_add_epi64(charger_4x##SUF(v + j),                       \
+                        _mm256_loadu_si256((const __m256i *)(pot_c + j)));          \
+        __m256i c1 = _mm256_add_epi64(charger_4x##SUF(v + j + 4),                   \
+                        _mm256_loadu_si256((const __m256i *)(pot_c + j + 4)));      \
+        __m256i sous = _mm256_or_si256(                                             \
+            _mm256_cmpgt_epi64(s, _mm256_sub_epi64(c0, u)),                         \
+            _mm256_cmpgt_epi64(s, _mm256_sub_epi64(c1, u)));                        \
+        if (!_mm256_movemask_epi8(sous))                                            \
+            continue;                                                               \
+        for (int t = j; t < j + 8; t++) {                                           \
+            long long marginal = (long long)v[t] - (u_i - pot_c[t]);                \
+            if (marginal < seuil && !(exclure && exclure(ctx, i, t))) {             \
+                seuil = marginal;                                                   \
+                indice = t;                                                         \
+            }                                                                       \
+        }                                                                           \
+        s = _mm256_set1_epi64x(seuil);                                              \
+    }                                                                               \
+    for (; j < nb; j++) {                                                           \
+        long long marginal = (long long)v[j] - (u_i - pot_c[j]);                    \
+        if (marginal < seuil && !(exclure && exclure(ctx, i, j))) {                 \
+            seuil = marginal;                                                       \
+            indice = j;                                                             \
+        }                                                                           \
+    }                                                                               \
+    *meilleur = seuil;                                                              \
+    return indice;                                                                  \
+}
+
+DEFINIR_MARGINAL(16, int16_t)
+DEFINIR_MARGINAL(32, int32_t)
+DEFINIR_MARGINAL(64, int64_t)
+
+#else
+
+int simd_disponible(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef COUTS_SIMD_H
+#define COUTS_SIMD_H
+
+#include <stdint.h>
+#include "couts.h"
+
+/*
+ * Noyaux vectoriels (AVX2) des lignes de coûts contiguës, utilisés par
+ * couts.c quand le processeur les supporte (détection à l'exécution).
+ * Résultats identiques aux noyaux scalaires : mêmes sentinelles, et à coût
+ * égal la première position l'emporte (ordre lexicographique coût, indice).
+ *
+ * Compiler avec -DCOUTS_SANS_SIMD pour ne garder que les noyaux scalaires.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(COUTS_SANS_SIMD)
+#define COUTS_SIMD 1
+#else
+#define COUTS_SIMD 0
+#endif
+
+// 1 si les noyaux AVX2 sont compilés et supportés par le processeur
+int simd_disponible(void);
+
+#if COUTS_SIMD
+
+void deux_minima_avx2_16(const int16_t *v, int nb, const int *actif, DeuxMinima *r);
+void deux_minima_avx2_32(const int32_t *v, int nb, const int *actif, DeuxMinima *r);
+
+int argmin_actif_avx2_16(const int16_t *v, int nb, const int *actif, long long *cout_min);
+int argmin_actif_avx2_32(const int32_t *v, int nb, const int *actif, long long *cout_min);
+
+int marginal_min_avx2_16(const int16_t *v, int nb, int i, long long u_i, const long long *pot_c,
+                         long long *meilleur, ExclusionCase exclure, const void *ctx);
+int marginal_min_avx2_32(const int32_t *v, int nb, int i, long long u_i, const long long *pot_c,
+                         long long *meilleur, ExclusionCase exclure, const void *ctx);
+int marginal_min_avx2_64(const int64_t *v, int nb, int i, long long u_i, const long long *pot_c,
+                         long long *meilleur, ExclusionCase exclure, const void *ctx);
+#endif
+
+#endif
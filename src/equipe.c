@@ -0,0 +1,150 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "equipe.h"
+
+#define MAX_MEMBRES 256
+
+typedef struct Membre {
+    struct Equipe *equipe;
+    int rang;
+} Membre;
+
+struct Equipe {
+    int nb_membres;
+    pthread_t *threads;       // membres 1 .. nb_membres - 1
+    Membre *membres;
+    pthread_mutex_t verrou;
+    pthread_cond_t depart;    // nouvelle tâche (ou arrêt)
+    pthread_cond_t fin;       // dernier membre terminé
+    unsigned long generation; // numéro de la tâche en cours
+    int restants;             // membres (hors appelant) encore au travail
+    int arret;
+    TacheEquipe tache;
+    void *ctx;
+};
+
+int nb_coeurs(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 1) ? (int)n : 1;
+}
+
+static void *boucle_membre(void *arg)
+{
+    Membre *m = arg;
+    Equipe *e = m->equipe;
+    unsigned long vue = 0;
+
+    pthread_mutex_lock(&e->verrou);
+    while (1) {
+        while (e->generation == vue && !e->arret)
+            pthread_cond_wait(&e->depart, &e->verrou);
+        if (e->arret)
+            break;
+        vue = e->generation;
+        TacheEquipe tache = e->tache;
+        void *ctx = e->ctx;
+        pthread_mutex_unlock(&e->verrou);
+
+        tache(ctx, m->rang, e->nb_membres);
+
+        pthread_mutex_lock(&e->verrou);
+        if (--e->restants == 0)
+            pthread_cond_signal(&e->fin);
+    }
+    pthread_mutex_unlock(&e->verrou);
+    return NULL;
+}
+
+// Arrête et attend les nb_lances premiers membres
+static void arreter_membres(Equipe *e, int nb_lances)
+{
+    pthread_mutex_lock(&e->verrou);
+    e->arret = 1;
+    pthread_cond_broadcast(&e->depart);
+    pthread_mutex_unlock(&e->verrou);
+
+    for (int t = 0; t < nb_lances; t++)
+        pthread_join(e->threads[t], NULL);
+}
+
+Equipe *creer_equipe(int nb_threads)
+{
+    if (nb_threads <= 0)
+        nb_threads = nb_coeurs();
+    if (nb_threads > MAX_MEMBRES)
+        nb_threads = MAX_MEMBRES;
+
+    Equipe *e = calloc(1, sizeof(Equipe));
+    if (!e)
+        return NULL;
+    e->nb_membres = nb_threads;
+    e->threads = malloc((size_t)nb_threads * sizeof(pthread_t));
+    e->membres = malloc((size_t)nb_threads * sizeof(Membre));
+    if (!e->threads || !e->membres) {
+        free(e->threads);
+        free(e->membres);
+        free(e);
+        return NULL;
+    }
+
+    pthread_mutex_init(&e->verrou, NULL);
+    pthread_cond_init(&e->depart, NULL);
+    pthread_cond_init(&e->fin, NULL);
+
+    for (int t = 1; t < nb_threads; t++) {
+        e->membres[t].equipe = e;
+        e->membres[t].rang = t;
+        if (pthread_create(&e->threads[t - 1], NULL, boucle_membre, &e->membres[t]) != 0) {
+            arreter_membres(e, t - 1);
+            e->nb_membres = 1;
+            detruire_equipe(e);
+            return NULL;
+        }
+    }
+    return e;
+}
+
+void detruire_equipe(Equipe *e)
+{
+    if (!e)
+        return;
+    if (e->nb_membres > 1)
+        arreter_membres(e, e->nb_membres - 1);
+
+    pthread_mutex_destroy(&e->verrou);
+    pthread_cond_destroy(&e->depart);
+    pthread_cond_destroy(&e->fin);
+    free(e->threads);
+    free(e->membres);
+    free(e);
+}
+
+int taille_equipe(const Equipe *e)
+{
+    return e ? e->nb_membres : 1;
+}
+
+void executer_equipe(Equipe *e, TacheEquipe tache, void *ctx)
+{
+    if (!e || e->nb_membres == 1) {
+        tache(ctx, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&e->verrou);
+    e->tache = tache;
+    e->ctx = ctx;
+    e->restants = e->nb_membres - 1;
+    e->generation++;
+    pthread_cond_broadcast(&e->depart);
+    pthread_mutex_unlock(&e->verrou);
+
+    tache(ctx, 0, e->nb_membres);
+
+    pthread_mutex_lock(&e->verrou);
+    while (e->restants > 0)
+        pthread_cond_wait(&e->fin, &e->verrou);
+    pthread_mutex_unlock(&e->verrou);
+}
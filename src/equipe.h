@@ -0,0 +1,37 @@
+#ifndef EQUIPE_H
+#define EQUIPE_H
+
+/*
+ * Équipe de threads réutilisable : les mêmes threads exécutent une suite de
+ * tâches courtes (une par étape d'une méthode itérative) sans être recréés.
+ *
+ * executer_equipe() lance la tâche sur chaque membre, le thread appelant
+ * étant le membre 0, et rend la main quand tous ont terminé. Chaque membre
+ * reçoit son rang et la taille de l'équipe pour choisir sa part du travail ;
+ * la tâche ne doit pas appeler trace() (sorties propres à chaque thread).
+ */
+
+typedef struct Equipe Equipe;
+
+typedef void (*TacheEquipe)(void *ctx, int rang, int nb_membres);
+
+// Nombre de cœurs disponibles (au moins 1)
+int nb_coeurs(void);
+
+// Crée une équipe de nb_threads membres (0 : un par cœur), appelant compris.
+// Renvoie NULL si les threads ne peuvent être créés.
+Equipe *creer_equipe(int nb_threads);
+void detruire_equipe(Equipe *e);
+
+int taille_equipe(const Equipe *e);
+
+void executer_equipe(Equipe *e, TacheEquipe tache, void *ctx);
+
+// Part [*debut, *fin[ de nb éléments revenant au membre rang
+static inline void part_equipe(int nb, int rang, int nb_membres, int *debut, int *fin)
+{
+    *debut = (int)((long long)nb * rang / nb_membres);
+    *fin = (int)((long long)nb * (rang + 1) / nb_membres);
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include <string.h>
+#include "heuristiques.h"
+#include "nord_ouest.h"
+#include "balas_hammer.h"
+#include "cout_minimal.h"
+#include "minimum_ligne.h"
+#include "russell.h"
+
+static void methode_nord_ouest(const Probleme *p, Solution *s, int nb_threads)
+{
+    (void)nb_threads;
+    coin_nord_ouest(p, s);
+}
+
+static void methode_cout_minimal(const Probleme *p, Solution *s, int nb_threads)
+{
+    (void)nb_threads;
+    cout_minimal(p, s);
+}
+
+static void methode_minimum_ligne(const Probleme *p, Solution *s, int nb_threads)
+{
+    (void)nb_threads;
+    minimum_ligne(p, s);
+}
+
+static void methode_russell(const Probleme *p, Solution *s, int nb_threads)
+{
+    (void)nb_threads;
+    russell(p, s);
+}
+
+static Heuristique registre[MAX_HEURISTIQUES] = {
+    { "no", "NORD-OUEST",        methode_nord_ouest },
+    { "bh", "BALAS-HAMMER",      balas_hammer_parallele },
+    { "cm", "COÛT MINIMAL",      methode_cout_minimal },
+    { "ml", "MINIMUM PAR LIGNE", methode_minimum_ligne },
+    { "ru", "RUSSELL",           methode_russell },
+};
+static int nb_enregistrees = 5;
+
+const Heuristique *trouver_heuristique(const char *nom)
+{
+    for (int k = 0; k < nb_enregistrees; k++)
+        if (strcmp(registre[k].nom, nom) == 0)
+            return &registre[k];
+    return NULL;
+}
+
+int nb_heuristiques(void)
+{
+    return nb_enregistrees;
+}
+
+const Heuristique *heuristique(int k)
+{
+    return (k >= 0 && k < nb_enregistrees) ? &registre[k] : NULL;
+}
+
+int enregistrer_heuristique(const char *nom, const char *titre, MethodeInitiale calculer)
+{
+    if (nb_enregistrees == MAX_HEURISTIQUES || !calculer || trouver_heuristique(nom))
+        return -1;
+    registre[nb_enregistrees++] = (Heuristique){ nom, titre, calculer };
+    return 0;
+}
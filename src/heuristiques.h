@@ -0,0 +1,40 @@
+#ifndef HEURISTIQUES_H
+#define HEURISTIQUES_H
+
+#include "problem.h"
+
+/*
+ * Registre des méthodes de proposition initiale, choisies par leur nom
+ * (transport, complexite, transport_solve). Méthodes fournies :
+ *   no  Nord-Ouest            bh  Balas-Hammer
+ *   cm  coût minimal          ml  minimum par ligne
+ *   ru  Russell
+ *
+ * nb_threads est le nombre de threads accordé à la méthode (0 : un par
+ * cœur) ; une méthode séquentielle l'ignore. La proposition ne doit pas
+ * en dépendre.
+ */
+
+typedef void (*MethodeInitiale)(const Probleme *p, Solution *s, int nb_threads);
+
+typedef struct {
+    const char *nom;        // nom court, en ligne de commande
+    const char *titre;      // titre des traces
+    MethodeInitiale calculer;
+} Heuristique;
+
+#define MAX_HEURISTIQUES 16
+
+// Méthode de ce nom, ou NULL
+const Heuristique *trouver_heuristique(const char *nom);
+
+// Méthodes enregistrées, dans l'ordre : fournies puis ajoutées
+int nb_heuristiques(void);
+const Heuristique *heuristique(int k);
+
+// Ajoute une méthode (chaînes conservées telles quelles). À appeler avant
+// toute résolution : le registre n'est pas protégé contre les accès
+// concurrents. Renvoie 0, ou -1 si le nom existe déjà ou le registre est plein.
+int enregistrer_heuristique(const char *nom, const char *titre, MethodeInitiale calculer);
+
+#endif
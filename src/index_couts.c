@@ -0,0 +1,158 @@
+#include <stdlib.h>
+#include "index_couts.h"
+#include "couts.h"
+#include "tuiles.h"
+
+typedef struct {
+    long long cout;
+    int indice;
+} CoutIndice;
+
+static int comparer_cout_indice(const void *a, const void *b)
+{
+    const CoutIndice *x = a, *y = b;
+    if (x->cout != y->cout)
+        return (x->cout < y->cout) ? -1 : 1;
+    return (x->indice > y->indice) - (x->indice < y->indice);
+}
+
+// Espace de travail d'un thread, dimensionné pour la plus longue ligne/colonne
+typedef struct {
+    long long *cles;
+    int *compte;        // tri par dénombrement : 4 * taille + 2 cases
+    CoutIndice *paires; // tri par comparaison
+    int *tampon;        // variante implicite
+} Travail;
+
+/*
+ * Trie les indices 0..nb-1 par clé croissante (puis indice croissant).
+ * Les coûts ont souvent une petite amplitude (distances, coûts bornés) :
+ * un tri par dénombrement, stable et linéaire, suffit alors. Sinon qsort.
+ */
+static void trier_indices(const long long *cles, int nb, int *ordre, Travail *w)
+{
+    if (nb == 0)
+        return;
+
+    long long min = cles[0], max = cles[0];
+    for (int k = 1; k < nb; k++) {
+        if (cles[k] < min) min = cles[k];
+        if (cles[k] > max) max = cles[k];
+    }
+
+    if ((unsigned long long)max - (unsigned long long)min <= 4ULL * (unsigned long long)nb) {
+        int amplitude = (int)(max - min) + 1;
+        for (int v = 0; v <= amplitude; v++)
+            w->compte[v] = 0;
+        for (int k = 0; k < nb; k++)
+            w->compte[cles[k] - min + 1]++;
+        for (int v = 1; v <= amplitude; v++)
+            w->compte[v] += w->compte[v - 1];
+        for (int k = 0; k < nb; k++)
+            ordre[w->compte[cles[k] - min]++] = k;
+        return;
+    }
+
+    for (int k = 0; k < nb; k++) {
+        w->paires[k].cout = cles[k];
+        w->paires[k].indice = k;
+    }
+    qsort(w->paires, (size_t)nb, sizeof(CoutIndice), comparer_cout_indice);
+    for (int k = 0; k < nb; k++)
+        ordre[k] = w->paires[k].indice;
+}
+
+typedef struct {
+    const Probleme *p;
+    IndexCouts *x;
+    Travail *travail;   // un espace de travail par membre de l'équipe
+} TacheIndex;
+
+static void indexer_part(void *arg, int rang, int nb_membres)
+{
+    TacheIndex *t = arg;
+    const Probleme *p = t->p;
+    IndexCouts *x = t->x;
+    Travail *w = &t->travail[rang];
+    int debut, fin;
+
+    part_equipe(p->nb_fournisseurs, rang, nb_membres, &debut, &fin);
+    for (int i = debut; i < fin; i++) {
+        copier_ligne_couts(p, i, w->tampon, w->cles);
+        trier_indices(w->cles, p->nb_clients, x->par_ligne + (size_t)i * p->nb_clients, w);
+    }
+
+    part_equipe(p->nb_clients, rang, nb_membres, &debut, &fin);
+    for (int j = debut; j < fin; j++) {
+        copier_colonne_couts(p, j, w->tampon, w->cles);
+        trier_indices(w->cles, p->nb_fournisseurs,
+                      x->par_colonne + (size_t)j * p->nb_fournisseurs, w);
+    }
+}
+
+static int allouer_travail(Travail *w, int taille)
+{
+    w->cles = malloc((size_t)taille * sizeof(long long));
+    w->compte = malloc(((size_t)taille * 4 + 2) * sizeof(int));
+    w->paires = malloc((size_t)taille * sizeof(CoutIndice));
+    w->tampon = malloc((size_t)taille * sizeof(int));
+    return w->cles && w->compte && w->paires && w->tampon;
+}
+
+static void liberer_travail(Travail *w)
+{
+    free(w->cles);
+    free(w->compte);
+    free(w->paires);
+    free(w->tampon);
+}
+
+IndexCouts *construire_index_couts(const Probleme *p, Equipe *equipe)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    if (est_creux(p) || n <= 0 || m <= 0)
+        return NULL;
+    if ((size_t)n * (size_t)m * 2 * sizeof(int) > INDEX_COUTS_OCTETS_MAX)
+        return NULL;
+
+    IndexCouts *x = malloc(sizeof(IndexCouts));
+    if (!x)
+        return NULL;
+    x->nb_fournisseurs = n;
+    x->nb_clients = m;
+    x->par_ligne = malloc((size_t)n * m * sizeof(int));
+    x->par_colonne = malloc((size_t)n * m * sizeof(int));
+
+    int nb_membres = taille_equipe(equipe);
+    TacheIndex tache = { p, x, calloc((size_t)nb_membres, sizeof(Travail)) };
+    int ok = x->par_ligne && x->par_colonne && tache.travail;
+    for (int r = 0; r < nb_membres && ok; r++)
+        ok = allouer_travail(&tache.travail[r], taille_tampon_couts(p));
+
+    if (ok)
+        executer_equipe(equipe, indexer_part, &tache);
+
+    for (int r = 0; tache.travail && r < nb_membres; r++)
+        liberer_travail(&tache.travail[r]);
+    free(tache.travail);
+
+    if (!ok) {
+        liberer_index_couts(x);
+        return NULL;
+    }
+
+    // La matrice a été lue une fois par lignes et une fois par colonnes
+    compter_lignes_lues(p, 2 * n);
+    return x;
+}
+
+void liberer_index_couts(IndexCouts *x)
+{
+    if (!x)
+        return;
+    free(x->par_ligne);
+    free(x->par_colonne);
+    free(x);
+}
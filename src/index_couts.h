@@ -0,0 +1,56 @@
+#ifndef INDEX_COUTS_H
+#define INDEX_COUTS_H
+
+#include "problem.h"
+#include "equipe.h"
+
+/*
+ * Index des coûts triés, construit une fois avant une méthode gloutonne
+ * (Balas-Hammer, coût minimal...) : pour chaque ligne, ses colonnes par coût
+ * croissant, et pour chaque colonne, ses lignes par coût croissant. À coût
+ * égal, l'indice le plus petit vient d'abord, comme la première occurrence
+ * retenue par les noyaux de couts.h.
+ *
+ * Une ligne ou colonne qui ne fait que perdre des cases actives garde un
+ * curseur dans son ordre : il ne recule jamais, si bien que chercher le
+ * plus petit coût actif revient en moyenne à O(1) sur toute la méthode.
+ *
+ * Réservé aux matrices denses ou implicites tenant dans INDEX_COUTS_OCTETS_MAX
+ * (2 x n x m entiers) ; le tri est réparti entre les membres d'une équipe.
+ */
+
+#define INDEX_COUTS_OCTETS_MAX ((size_t)256 << 20)
+
+typedef struct IndexCouts {
+    int nb_fournisseurs;
+    int nb_clients;
+    int *par_ligne;     // n x m : ligne i en i * nb_clients
+    int *par_colonne;   // m x n : colonne j en j * nb_fournisseurs
+} IndexCouts;
+
+// Construit l'index en répartissant lignes et colonnes entre les membres de
+// l'équipe (NULL : thread appelant seul). Renvoie NULL pour une matrice
+// creuse, au-delà du budget mémoire ou si l'allocation échoue.
+IndexCouts *construire_index_couts(const Probleme *p, Equipe *equipe);
+void liberer_index_couts(IndexCouts *x);
+
+// Colonnes de la ligne i, lignes de la colonne j, par coût croissant
+static inline const int *index_ligne(const IndexCouts *x, int i)
+{
+    return x->par_ligne + (size_t)i * x->nb_clients;
+}
+
+static inline const int *index_colonne(const IndexCouts *x, int j)
+{
+    return x->par_colonne + (size_t)j * x->nb_fournisseurs;
+}
+
+// Première position >= pos de ordre[] dont l'élément est actif (nb si aucune)
+static inline int avancer_curseur(const int *ordre, int nb, int pos, const int *actif)
+{
+    while (pos < nb && !actif[ordre[pos]])
+        pos++;
+    return pos;
+}
+
+#endif
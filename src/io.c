@@ -0,0 +1,910 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "io.h"
+#include "utils.h"
+#include "couts.h"
+#include "lot.h"
+
+// En dessous de ce nombre de cases, le découpage en threads ne vaut pas le coût
+#define SEUIL_LECTURE_PARALLELE (1 << 20)
+#define MAX_THREADS_LECTURE 16
+
+/*
+ * Tampon d'entrée ----------------------------------------------------------
+ */
+
+typedef struct {
+    const char *debut;
+    const char *fin;
+    size_t taille;
+    int projete;        // 1 si obtenu par mmap, 0 si lu dans un malloc
+} Tampon;
+
+static int ouvrir_tampon(const char *nom_fichier, Tampon *t)
+{
+    int fd = open(nom_fichier, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *adr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (adr != MAP_FAILED) {
+            madvise(adr, (size_t)st.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            t->debut = adr;
+            t->taille = (size_t)st.st_size;
+            t->fin = t->debut + t->taille;
+            t->projete = 1;
+            return 0;
+        }
+    }
+
+    // Repli (tube, fichier spécial...) : lecture complète en mémoire
+    size_t cap = 1 << 16, taille = 0;
+    char *buf = malloc(cap);
+    ssize_t lu;
+    while (buf && (lu = read(fd, buf + taille, cap - taille)) > 0) {
+        taille += (size_t)lu;
+        if (taille == cap) {
+            char *nouveau = realloc(buf, cap * 2);
+            if (!nouveau) { free(buf); buf = NULL; break; }
+            buf = nouveau;
+            cap *= 2;
+        }
+    }
+    close(fd);
+    if (!buf)
+        return -1;
+
+    t->debut = buf;
+    t->taille = taille;
+    t->fin = buf + taille;
+    t->projete = 0;
+    return 0;
+}
+
+static void fermer_tampon(Tampon *t)
+{
+    if (t->projete)
+        munmap((void *)t->debut, t->taille);
+    else
+        free((void *)t->debut);
+}
+
+/*
+ * Analyse des entiers -------------------------------------------------------
+ */
+
+static inline const char *sauter_blancs(const char *c, const char *fin)
+{
+    while (c < fin && (unsigned char)*c <= ' ')
+        c++;
+    return c;
+}
+
+// Lit un entier signé 64 bits à partir de c. Renvoie la position suivante, ou
+// NULL si le texte n'est pas un entier valide (la position fautive est alors dans *erreur).
+static inline const char *lire_entier64(const char *c, const char *fin, long long *val,
+                                        const char **erreur)
+{
+    c = sauter_blancs(c, fin);
+    const char *debut = c;
+
+    int negatif = 0;
+    if (c < fin && (*c == '-' || *c == '+')) {
+        negatif = (*c == '-');
+        c++;
+    }
+
+    unsigned long long v = 0;
+    const char *chiffres = c;
+    unsigned d;
+    while (c < fin && (d = (unsigned)(*c - '0')) < 10) {
+        if (v > ((unsigned long long)LLONG_MAX + 1 - d) / 10) {
+            *erreur = debut;
+            return NULL;
+        }
+        v = v * 10 + d;
+        c++;
+    }
+
+    // Il faut au moins un chiffre, suivi d'un blanc ou de la fin du fichier
+    if (c == chiffres || (c < fin && (unsigned char)*c > ' ')) {
+        *erreur = (c == chiffres) ? debut : c;
+        return NULL;
+    }
+
+    if (!negatif && v > (unsigned long long)LLONG_MAX) {
+        *erreur = debut;
+        return NULL;
+    }
+
+    *val = negatif ? (long long)(0 - v) : (long long)v;
+    return c;
+}
+
+// Même chose pour un int (quantités, dimensions)
+static inline const char *lire_entier(const char *c, const char *fin, int *val,
+                                      const char **erreur)
+{
+    long long v;
+    const char *debut = sauter_blancs(c, fin);
+    c = lire_entier64(debut, fin, &v, erreur);
+    if (!c)
+        return NULL;
+
+    if (v < INT_MIN || v > INT_MAX) {
+        *erreur = debut;
+        return NULL;
+    }
+
+    *val = (int)v;
+    return c;
+}
+
+// Lit un coût dans la case j de la ligne (32 ou 64 bits selon le stockage).
+// Un coût hors de l'intervalle 32 bits lève *debordement : l'appelant relit
+// alors le fichier avec un stockage 64 bits.
+static inline const char *lire_cout(const char *c, const char *fin, const Probleme *p,
+                                    void *ligne, int j, const char **erreur, int *debordement)
+{
+    long long v;
+    const char *debut = sauter_blancs(c, fin);
+    c = lire_entier64(debut, fin, &v, erreur);
+    if (!c)
+        return NULL;
+
+    if (p->largeur_couts == 8) {
+        ((int64_t *)ligne)[j] = v;
+    } else if (v < INT32_MIN || v > INT32_MAX) {
+        *erreur = debut;
+        *debordement = 1;
+        return NULL;
+    } else {
+        ((int32_t *)ligne)[j] = (int32_t)v;
+    }
+    return c;
+}
+
+// Lit un réel décimal simple (signe, chiffres, partie décimale facultative)
+static const char *lire_reel(const char *c, const char *fin, double *val,
+                             const char **erreur)
+{
+    c = sauter_blancs(c, fin);
+    const char *debut = c;
+
+    double signe = 1.0;
+    if (c < fin && (*c == '-' || *c == '+')) {
+        if (*c == '-') signe = -1.0;
+        c++;
+    }
+
+    double v = 0.0;
+    int nb_chiffres = 0;
+    unsigned d;
+    while (c < fin && (d = (unsigned)(*c - '0')) < 10) {
+        v = v * 10.0 + d;
+        nb_chiffres++;
+        c++;
+    }
+    if (c < fin && *c == '.') {
+        double echelle = 0.1;
+        c++;
+        while (c < fin && (d = (unsigned)(*c - '0')) < 10) {
+            v += d * echelle;
+            echelle *= 0.1;
+            nb_chiffres++;
+            c++;
+        }
+    }
+
+    if (nb_chiffres == 0 || (c < fin && (unsigned char)*c > ' ')) {
+        *erreur = nb_chiffres ? c : debut;
+        return NULL;
+    }
+
+    *val = signe * v;
+    return c;
+}
+
+// Calcule ligne/colonne d'une position ; appelé seulement en cas d'erreur
+static void positionner_erreur(const Tampon *t, const char *pos,
+                               const char *message, ErreurLecture *err)
+{
+    if (!err)
+        return;
+
+    int ligne = 1, colonne = 1;
+    for (const char *c = t->debut; c < pos && c < t->fin; c++) {
+        if (*c == '\n') { ligne++; colonne = 1; }
+        else colonne++;
+    }
+
+    err->ligne = ligne;
+    err->colonne = colonne;
+    snprintf(err->message, sizeof(err->message), "%s", message);
+}
+
+/*
+ * Lecture séquentielle (format libre : seuls les blancs séparent les valeurs)
+ */
+
+static const char *lire_tableau_sequentiel(Probleme *p, const char *c, const char *fin,
+                                           const char **erreur, int *debordement)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    for (int i = 0; i < n && c; i++) {
+        void *ligne = ligne_couts(p, i);
+        for (int j = 0; j < m && c; j++)
+            c = lire_cout(c, fin, p, ligne, j, erreur, debordement);
+        if (c)
+            c = lire_entier(c, fin, &p->provisions[i], erreur);
+    }
+    return c;
+}
+
+/*
+ * Lecture parallèle : une ligne du fichier par fournisseur
+ */
+
+typedef struct {
+    Probleme *p;
+    const char **debuts_lignes;  // debuts_lignes[i] = début de la ligne du fournisseur i
+    const char *fin;
+    int premiere, derniere;      // lignes [premiere, derniere[
+    const char *erreur;          // NULL si tout s'est bien passé
+    int debordement;             // coût hors de l'intervalle 32 bits rencontré
+} TacheLecture;
+
+static void *lire_lignes_thread(void *arg)
+{
+    TacheLecture *t = arg;
+    int m = t->p->nb_clients;
+
+    for (int i = t->premiere; i < t->derniere; i++) {
+        const char *c = t->debuts_lignes[i];
+        const char *fin_ligne = memchr(c, '\n', (size_t)(t->fin - c));
+        if (!fin_ligne)
+            fin_ligne = t->fin;
+
+        void *ligne = ligne_couts(t->p, i);
+        for (int j = 0; j < m && c; j++)
+            c = lire_cout(c, fin_ligne, t->p, ligne, j, &t->erreur, &t->debordement);
+        if (c)
+            c = lire_entier(c, fin_ligne, &t->p->provisions[i], &t->erreur);
+
+        if (!c)
+            return NULL;
+        if (sauter_blancs(c, fin_ligne) != fin_ligne) {
+            t->erreur = c;
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+// Renvoie la position après la dernière ligne du tableau, ou NULL si la
+// disposition "une ligne par fournisseur" n'est pas respectée.
+static const char *lire_tableau_parallele(Probleme *p, const char *c, const char *fin)
+{
+    int n = p->nb_fournisseurs;
+
+    long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+    int nb_threads = (nb_coeurs > 1) ? (int)nb_coeurs : 1;
+    if (nb_threads > MAX_THREADS_LECTURE) nb_threads = MAX_THREADS_LECTURE;
+    if (nb_threads > n) nb_threads = n;
+    if (nb_threads < 2)
+        return NULL;
+
+    const char **debuts = malloc((size_t)n * sizeof(char *));
+    if (!debuts)
+        return NULL;
+
+    // Repérage des débuts de ligne (memchr est vectorisé par la libc)
+    c = memchr(c, '\n', (size_t)(fin - c));
+    for (int i = 0; i < n; i++) {
+        if (!c || c + 1 >= fin) { free(debuts); return NULL; }
+        debuts[i] = c + 1;
+        c = memchr(c + 1, '\n', (size_t)(fin - c - 1));
+    }
+    const char *apres = c ? c + 1 : fin;
+
+    pthread_t threads[MAX_THREADS_LECTURE];
+    TacheLecture taches[MAX_THREADS_LECTURE];
+    int lances = 0;
+
+    for (int t = 0; t < nb_threads; t++) {
+        taches[t].p = p;
+        taches[t].debuts_lignes = debuts;
+        taches[t].fin = fin;
+        taches[t].premiere = (int)((long long)n * t / nb_threads);
+        taches[t].derniere = (int)((long long)n * (t + 1) / nb_threads);
+        taches[t].erreur = NULL;
+        taches[t].debordement = 0;
+        if (pthread_create(&threads[t], NULL, lire_lignes_thread, &taches[t]) != 0)
+            break;
+        lances++;
+    }
+
+    int ok = (lances == nb_threads);
+    for (int t = 0; t < lances; t++) {
+        pthread_join(threads[t], NULL);
+        if (taches[t].erreur)
+            ok = 0;
+    }
+
+    free(debuts);
+    return ok ? apres : NULL;
+}
+
+/*
+ * Variante creuse : "creux n m k", puis k triplets "i j cout", puis P_i et C_j
+ */
+
+static Probleme *lire_probleme_creux(const Tampon *t, const char *c, ErreurLecture *err)
+{
+    const char *erreur = NULL;
+    int n = 0, m = 0, k = 0;
+
+    c = lire_entier(c, t->fin, &n, &erreur);
+    if (c) c = lire_entier(c, t->fin, &m, &erreur);
+    if (c) c = lire_entier(c, t->fin, &k, &erreur);
+    if (!c) {
+        positionner_erreur(t, erreur, "en-tête attendu : creux <nb_fournisseurs> <nb_clients> <nb_arcs>", err);
+        return NULL;
+    }
+
+    Probleme *p = creer_probleme_creux(n, m, k);
+    int *triplets = malloc(((size_t)k + 1) * 3 * sizeof(int));
+    if (!p || !triplets) {
+        positionner_erreur(t, t->debut, "dimensions invalides ou mémoire insuffisante", err);
+        liberer_probleme(p);
+        free(triplets);
+        return NULL;
+    }
+
+    const char *message = "entier attendu";
+    for (int a = 0; a < k && c; a++) {
+        const char *debut_arc = sauter_blancs(c, t->fin);
+        int *tr = &triplets[3 * a];
+        c = lire_entier(c, t->fin, &tr[0], &erreur);
+        if (c) c = lire_entier(c, t->fin, &tr[1], &erreur);
+        if (c) c = lire_entier(c, t->fin, &tr[2], &erreur);
+        if (c && (tr[0] < 0 || tr[0] >= n || tr[1] < 0 || tr[1] >= m)) {
+            message = "arc hors des dimensions du problème";
+            erreur = debut_arc;
+            c = NULL;
+        }
+        if (c)
+            p->debut_ligne[tr[0] + 1]++;
+    }
+
+    for (int i = 0; i < n && c; i++)
+        c = lire_entier(c, t->fin, &p->provisions[i], &erreur);
+    for (int j = 0; j < m && c; j++)
+        c = lire_entier(c, t->fin, &p->commandes[j], &erreur);
+
+    if (c && sauter_blancs(c, t->fin) != t->fin) {
+        message = "données en trop après les commandes";
+        erreur = sauter_blancs(c, t->fin);
+        c = NULL;
+    }
+
+    if (!c) {
+        if (erreur >= t->fin) message = "fin de fichier prématurée";
+        positionner_erreur(t, erreur, message, err);
+        liberer_probleme(p);
+        free(triplets);
+        return NULL;
+    }
+
+    // Passage en CSR : préfixes des degrés puis répartition des triplets
+    for (int i = 0; i < n; i++)
+        p->debut_ligne[i + 1] += p->debut_ligne[i];
+
+    int *curseur = malloc((size_t)n * sizeof(int));
+    if (curseur) {
+        memcpy(curseur, p->debut_ligne, (size_t)n * sizeof(int));
+        for (int a = 0; a < k; a++) {
+            int pos = curseur[triplets[3 * a]]++;
+            p->arc_client[pos] = triplets[3 * a + 1];
+            p->arc_cout[pos] = triplets[3 * a + 2];
+        }
+    }
+    free(curseur);
+    free(triplets);
+
+    if (!curseur || finaliser_probleme_creux(p) != 0) {
+        positionner_erreur(t, t->debut, curseur ? "arc déclaré deux fois" : "mémoire insuffisante", err);
+        liberer_probleme(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+/*
+ * Variante implicite : "coordonnees n m METRIQUE", puis n lignes "x y P_i"
+ * et m lignes "x y C_j". METRIQUE vaut L1, L2 ou L2R (L2 arrondi).
+ */
+
+static int lire_metrique(const char **c, const char *fin)
+{
+    const char *mot = sauter_blancs(*c, fin);
+    const char *f = mot;
+    while (f < fin && (unsigned char)*f > ' ')
+        f++;
+
+    size_t lg = (size_t)(f - mot);
+    int metrique = METRIQUE_AUCUNE;
+    if (lg == 2 && memcmp(mot, "L1", 2) == 0)       metrique = METRIQUE_L1;
+    else if (lg == 2 && memcmp(mot, "L2", 2) == 0)  metrique = METRIQUE_L2;
+    else if (lg == 3 && memcmp(mot, "L2R", 3) == 0) metrique = METRIQUE_L2_ARRONDI;
+
+    *c = (metrique == METRIQUE_AUCUNE) ? mot : f;
+    return metrique;
+}
+
+static Probleme *lire_probleme_implicite(const Tampon *t, const char *c, ErreurLecture *err)
+{
+    const char *erreur = NULL;
+    int n = 0, m = 0;
+
+    c = lire_entier(c, t->fin, &n, &erreur);
+    if (c) c = lire_entier(c, t->fin, &m, &erreur);
+    if (!c) {
+        positionner_erreur(t, erreur, "en-tête attendu : coordonnees <nb_fournisseurs> <nb_clients> <L1|L2|L2R>", err);
+        return NULL;
+    }
+
+    int metrique = lire_metrique(&c, t->fin);
+    if (metrique == METRIQUE_AUCUNE) {
+        positionner_erreur(t, c, "métrique attendue : L1, L2 ou L2R", err);
+        return NULL;
+    }
+
+    Probleme *p = creer_probleme_implicite(n, m, metrique);
+    if (!p) {
+        positionner_erreur(t, t->debut, "dimensions invalides ou mémoire insuffisante", err);
+        return NULL;
+    }
+
+    for (int i = 0; i < n && c; i++) {
+        c = lire_reel(c, t->fin, &p->x_f[i], &erreur);
+        if (c) c = lire_reel(c, t->fin, &p->y_f[i], &erreur);
+        if (c) c = lire_entier(c, t->fin, &p->provisions[i], &erreur);
+    }
+    for (int j = 0; j < m && c; j++) {
+        c = lire_reel(c, t->fin, &p->x_c[j], &erreur);
+        if (c) c = lire_reel(c, t->fin, &p->y_c[j], &erreur);
+        if (c) c = lire_entier(c, t->fin, &p->commandes[j], &erreur);
+    }
+
+    const char *message = "nombre attendu";
+    if (c && sauter_blancs(c, t->fin) != t->fin) {
+        message = "données en trop après les clients";
+        erreur = sauter_blancs(c, t->fin);
+        c = NULL;
+    }
+
+    if (!c) {
+        if (erreur >= t->fin) message = "fin de fichier prématurée";
+        positionner_erreur(t, erreur, message, err);
+        liberer_probleme(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+/*
+ * Point d'entrée -------------------------------------------------------------
+ */
+
+Probleme *charger_probleme_texte(const char *nom_fichier, ErreurLecture *err)
+{
+    Tampon t;
+    if (ouvrir_tampon(nom_fichier, &t) != 0) {
+        if (err) {
+            err->ligne = 0;
+            err->colonne = 0;
+            snprintf(err->message, sizeof(err->message), "ouverture impossible");
+        }
+        return NULL;
+    }
+
+    const char *erreur = NULL;
+    const char *c = t.debut;
+    int n = 0, m = 0;
+
+    const char *mot = sauter_blancs(c, t.fin);
+    if (t.fin - mot >= 5 && memcmp(mot, "creux", 5) == 0) {
+        Probleme *p = lire_probleme_creux(&t, mot + 5, err);
+        fermer_tampon(&t);
+        return p;
+    }
+    if (t.fin - mot >= 11 && memcmp(mot, "coordonnees", 11) == 0) {
+        Probleme *p = lire_probleme_implicite(&t, mot + 11, err);
+        fermer_tampon(&t);
+        return p;
+    }
+
+    c = lire_entier(c, t.fin, &n, &erreur);
+    if (c) c = lire_entier(c, t.fin, &m, &erreur);
+    if (!c) {
+        positionner_erreur(&t, erreur, "en-tête attendu : <nb_fournisseurs> <nb_clients>", err);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    // Lecture sur 32 bits ; si un coût n'y tient pas, on recommence sur 64 bits
+    Probleme *p = NULL;
+    const char *suite = NULL;
+    int debordement = 0;
+    for (int largeur = 4; largeur <= 8; largeur += 4) {
+        p = creer_probleme_largeur(n, m, largeur);
+        if (!p) {
+            positionner_erreur(&t, t.debut, "dimensions invalides ou mémoire insuffisante", err);
+            fermer_tampon(&t);
+            return NULL;
+        }
+
+        if ((long long)n * m >= SEUIL_LECTURE_PARALLELE)
+            suite = lire_tableau_parallele(p, c, t.fin);
+
+        // Format libre, ou disposition inattendue : la lecture séquentielle fait foi
+        debordement = 0;
+        if (!suite)
+            suite = lire_tableau_sequentiel(p, c, t.fin, &erreur, &debordement);
+
+        if (!debordement)
+            break;
+        liberer_probleme(p);
+        p = NULL;
+    }
+
+    for (int j = 0; j < m && suite; j++)
+        suite = lire_entier(suite, t.fin, &p->commandes[j], &erreur);
+
+    if (!suite) {
+        positionner_erreur(&t, erreur,
+                           (erreur >= t.fin) ? "fin de fichier prématurée" : "entier attendu", err);
+        liberer_probleme(p);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    suite = sauter_blancs(suite, t.fin);
+    if (suite != t.fin) {
+        positionner_erreur(&t, suite, "données en trop après les commandes", err);
+        liberer_probleme(p);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    fermer_tampon(&t);
+
+    // Stockage à la plus petite largeur qui contient toutes les valeurs
+    adapter_largeur_couts(p);
+    return p;
+}
+
+/*
+ * Lot d'instances --------------------------------------------------------------
+ */
+
+LotProblemes *charger_lot_texte(const char *nom_fichier, ErreurLecture *err)
+{
+    Tampon t;
+    if (ouvrir_tampon(nom_fichier, &t) != 0) {
+        if (err) {
+            err->ligne = 0;
+            err->colonne = 0;
+            snprintf(err->message, sizeof(err->message), "ouverture impossible");
+        }
+        return NULL;
+    }
+
+    const char *erreur = NULL;
+    const char *c = sauter_blancs(t.debut, t.fin);
+    int nb = 0, n = 0, m = 0;
+
+    if (t.fin - c >= 3 && memcmp(c, "lot", 3) == 0) {
+        c = lire_entier(c + 3, t.fin, &nb, &erreur);
+        if (c) c = lire_entier(c, t.fin, &n, &erreur);
+        if (c) c = lire_entier(c, t.fin, &m, &erreur);
+    } else {
+        erreur = c;
+        c = NULL;
+    }
+    if (!c) {
+        positionner_erreur(&t, erreur, "en-tête attendu : lot <nb_instances> <nb_fournisseurs> <nb_clients>", err);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    LotProblemes *l = creer_lot(nb, n, m);
+    if (!l) {
+        positionner_erreur(&t, t.debut, "dimensions invalides (1 à 16) ou mémoire insuffisante", err);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    const char *message = "entier attendu";
+    for (int k = 0; k < nb && c; k++) {
+        int *couts = l->couts + (size_t)k * n * m;
+        for (int i = 0; i < n && c; i++) {
+            for (int j = 0; j < m && c; j++) {
+                const char *debut = sauter_blancs(c, t.fin);
+                c = lire_entier(debut, t.fin, &couts[i * m + j], &erreur);
+                if (c && (couts[i * m + j] > LOT_COUT_MAX || couts[i * m + j] < -LOT_COUT_MAX)) {
+                    message = "coût hors de [-2^24, 2^24]";
+                    erreur = debut;
+                    c = NULL;
+                }
+            }
+            if (c) c = lire_entier(c, t.fin, &l->provisions[(size_t)k * n + i], &erreur);
+        }
+        for (int j = 0; j < m && c; j++)
+            c = lire_entier(c, t.fin, &l->commandes[(size_t)k * m + j], &erreur);
+    }
+
+    if (c && sauter_blancs(c, t.fin) != t.fin) {
+        message = "données en trop après la dernière instance";
+        erreur = sauter_blancs(c, t.fin);
+        c = NULL;
+    }
+
+    if (!c) {
+        if (erreur >= t.fin) message = "fin de fichier prématurée";
+        positionner_erreur(&t, erreur, message, err);
+        liberer_lot(l);
+        fermer_tampon(&t);
+        return NULL;
+    }
+
+    fermer_tampon(&t);
+    return l;
+}
+
+/*
+ * Format binaire ---------------------------------------------------------------
+ */
+
+static uint64_t arrondir_64(uint64_t taille)
+{
+    return (taille + ALIGNEMENT_MATRICE - 1) / ALIGNEMENT_MATRICE * ALIGNEMENT_MATRICE;
+}
+
+static void erreur_binaire(ErreurLecture *err, const char *message)
+{
+    if (!err)
+        return;
+    err->ligne = 0;
+    err->colonne = 0;
+    snprintf(err->message, sizeof(err->message), "%s", message);
+}
+
+int est_fichier_binaire(const char *nom_fichier)
+{
+    FILE *f = fopen(nom_fichier, "rb");
+    if (!f)
+        return 0;
+
+    char magie[4];
+    int ok = (fread(magie, 1, 4, f) == 4 && memcmp(magie, MAGIE_BINAIRE, 4) == 0);
+    fclose(f);
+    return ok;
+}
+
+// Section de nb éléments de taille_element octets à offset contenue dans le
+// fichier. Comparaisons par soustraction et division, sans calculer
+// offset + nb * taille_element (débordement sur 64 bits).
+static int section_valide(uint64_t offset, uint64_t nb, uint64_t taille_element, size_t taille)
+{
+    if (offset > taille)
+        return 0;
+    return nb <= (taille - offset) / taille_element;
+}
+
+// Sections [a, a + ta) et [b, b + tb) disjointes (bornes déjà validées)
+static int disjointes(uint64_t a, uint64_t ta, uint64_t b, uint64_t tb)
+{
+    return a + ta <= b || b + tb <= a;
+}
+
+Probleme *charger_probleme_binaire(const char *nom_fichier, ErreurLecture *err)
+{
+    int fd = open(nom_fichier, O_RDONLY);
+    if (fd < 0) {
+        erreur_binaire(err, "ouverture impossible");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(EnTeteBinaire)) {
+        close(fd);
+        erreur_binaire(err, "fichier binaire tronqué");
+        return NULL;
+    }
+
+    // Copie privée à l'écriture : le Probleme reste modifiable sans toucher au fichier
+    size_t taille = (size_t)st.st_size;
+    void *adr = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (adr == MAP_FAILED) {
+        erreur_binaire(err, "projection mémoire impossible");
+        return NULL;
+    }
+
+    const EnTeteBinaire *h = adr;
+    const char *message = NULL;
+    uint64_t taille_ligne = (uint64_t)h->pas * h->largeur;
+    uint64_t taille_provisions = (uint64_t)h->nb_fournisseurs * 4;
+    uint64_t taille_commandes = (uint64_t)h->nb_clients * 4;
+
+    if (memcmp(h->magie, MAGIE_BINAIRE, 4) != 0)
+        message = "signature binaire absente";
+    else if (h->ordre_octets != ORDRE_OCTETS)
+        message = "ordre des octets incompatible";
+    else if (h->version != VERSION_BINAIRE)
+        message = "version du format binaire non prise en charge";
+    else if (h->largeur != 2 && h->largeur != 4 && h->largeur != 8)
+        message = "largeur des coûts non prise en charge";
+    else if (h->nb_fournisseurs == 0 || h->nb_clients == 0 ||
+             h->nb_fournisseurs > INT_MAX || h->nb_clients > INT_MAX ||
+             h->pas < h->nb_clients || h->pas > INT_MAX)
+        message = "dimensions invalides";
+    else if (h->offset_provisions % ALIGNEMENT_MATRICE || h->offset_commandes % ALIGNEMENT_MATRICE ||
+             h->offset_couts % ALIGNEMENT_MATRICE)
+        message = "sections non alignées";
+    else if (h->taille_totale > taille ||
+             !section_valide(h->offset_provisions, h->nb_fournisseurs, 4, taille) ||
+             !section_valide(h->offset_commandes, h->nb_clients, 4, taille) ||
+             !section_valide(h->offset_couts, h->nb_fournisseurs, taille_ligne, taille))
+        message = "fichier binaire tronqué";
+    else if (h->offset_provisions < sizeof(EnTeteBinaire) ||
+             h->offset_commandes < sizeof(EnTeteBinaire) ||
+             h->offset_couts < sizeof(EnTeteBinaire) ||
+             !disjointes(h->offset_provisions, taille_provisions,
+                         h->offset_commandes, taille_commandes) ||
+             !disjointes(h->offset_provisions, taille_provisions,
+                         h->offset_couts, h->nb_fournisseurs * taille_ligne) ||
+             !disjointes(h->offset_commandes, taille_commandes,
+                         h->offset_couts, h->nb_fournisseurs * taille_ligne))
+        message = "sections qui se chevauchent";
+
+    if (message) {
+        munmap(adr, taille);
+        erreur_binaire(err, message);
+        return NULL;
+    }
+
+    Probleme *p = calloc(1, sizeof(Probleme));
+    if (!p) {
+        munmap(adr, taille);
+        erreur_binaire(err, "mémoire insuffisante");
+        return NULL;
+    }
+
+    char *base = adr;
+    p->nb_fournisseurs   = (int)h->nb_fournisseurs;
+    p->nb_clients        = (int)h->nb_clients;
+    p->largeur_couts     = (int)h->largeur;
+    p->pas_couts         = (int)h->pas;
+    p->provisions        = (int *)(base + h->offset_provisions);
+    p->commandes         = (int *)(base + h->offset_commandes);
+    p->couts             = base + h->offset_couts;
+    p->projection        = adr;
+    p->taille_projection = taille;
+
+    madvise(base + h->offset_couts, (size_t)(h->nb_fournisseurs * taille_ligne), MADV_WILLNEED);
+    return p;
+}
+
+static int ecrire_bourrage(FILE *f, uint64_t taille)
+{
+    static const char zeros[ALIGNEMENT_MATRICE] = {0};
+    return fwrite(zeros, 1, (size_t)(arrondir_64(taille) - taille), f) == arrondir_64(taille) - taille;
+}
+
+int ecrire_probleme_binaire(const Probleme *p, const char *nom_fichier)
+{
+    // Le format binaire ne décrit que des matrices denses stockées
+    if (!p->couts)
+        return -1;
+
+    FILE *f = fopen(nom_fichier, "wb");
+    if (!f)
+        return -1;
+
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    int largeur = p->largeur_couts;
+    int pas = pas_aligne(m, (size_t)largeur);
+
+    EnTeteBinaire h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magie, MAGIE_BINAIRE, 4);
+    h.version           = VERSION_BINAIRE;
+    h.ordre_octets      = ORDRE_OCTETS;
+    h.nb_fournisseurs   = (uint32_t)n;
+    h.nb_clients        = (uint32_t)m;
+    h.largeur           = (uint32_t)largeur;
+    h.pas               = (uint32_t)pas;
+    h.offset_provisions = arrondir_64(sizeof(EnTeteBinaire));
+    h.offset_commandes  = h.offset_provisions + arrondir_64((uint64_t)n * sizeof(int));
+    h.offset_couts      = h.offset_commandes + arrondir_64((uint64_t)m * sizeof(int));
+    h.taille_totale     = h.offset_couts + (uint64_t)n * pas * largeur;
+
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1
+          && ecrire_bourrage(f, sizeof(h))
+          && fwrite(p->provisions, sizeof(int), (size_t)n, f) == (size_t)n
+          && ecrire_bourrage(f, (uint64_t)n * sizeof(int))
+          && fwrite(p->commandes, sizeof(int), (size_t)m, f) == (size_t)m
+          && ecrire_bourrage(f, (uint64_t)m * sizeof(int));
+
+    // Lignes complètes (bourrage compris) : même disposition que le bloc aligné
+    char *ligne = calloc((size_t)pas, (size_t)largeur);
+    if (!ligne)
+        ok = 0;
+    for (int i = 0; i < n && ok; i++) {
+        memcpy(ligne, ligne_couts(p, i), (size_t)m * largeur);
+        ok = fwrite(ligne, (size_t)largeur, (size_t)pas, f) == (size_t)pas;
+    }
+    free(ligne);
+
+    if (fclose(f) != 0)
+        ok = 0;
+    return ok ? 0 : -1;
+}
+
+int ecrire_probleme_texte(const Probleme *p, const char *nom_fichier)
+{
+    FILE *f = fopen(nom_fichier, "w");
+    if (!f)
+        return -1;
+
+    if (est_creux(p)) {
+        fprintf(f, "creux %d %d %d\n", p->nb_fournisseurs, p->nb_clients, p->nb_arcs_autorises);
+        for (int i = 0; i < p->nb_fournisseurs; i++)
+            for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++)
+                fprintf(f, "%d %d %d\n", i, p->arc_client[k], p->arc_cout[k]);
+        for (int i = 0; i < p->nb_fournisseurs; i++)
+            fprintf(f, (i + 1 < p->nb_fournisseurs) ? "%d " : "%d\n", p->provisions[i]);
+        for (int j = 0; j < p->nb_clients; j++)
+            fprintf(f, (j + 1 < p->nb_clients) ? "%d " : "%d\n", p->commandes[j]);
+        return (fclose(f) == 0) ? 0 : -1;
+    }
+
+    if (est_implicite(p)) {
+        static const char *noms[] = { "", "L1", "L2", "L2R" };
+        fprintf(f, "coordonnees %d %d %s\n", p->nb_fournisseurs, p->nb_clients, noms[p->metrique]);
+        for (int i = 0; i < p->nb_fournisseurs; i++)
+            fprintf(f, "%.17g %.17g %d\n", p->x_f[i], p->y_f[i], p->provisions[i]);
+        for (int j = 0; j < p->nb_clients; j++)
+            fprintf(f, "%.17g %.17g %d\n", p->x_c[j], p->y_c[j], p->commandes[j]);
+        return (fclose(f) == 0) ? 0 : -1;
+    }
+
+    fprintf(f, "%d %d\n", p->nb_fournisseurs, p->nb_clients);
+    for (int i = 0; i < p->nb_fournisseurs; i++) {
+        for (int j = 0; j < p->nb_clients; j++)
+            fprintf(f, "%lld ", cout_dense(p, i, j));
+        fprintf(f, "%d\n", p->provisions[i]);
+    }
+    for (int j = 0; j < p->nb_clients; j++)
+        fprintf(f, (j + 1 < p->nb_clients) ? "%d " : "%d\n", p->commandes[j]);
+
+    return (fclose(f) == 0) ? 0 : -1;
+}
@@ -0,0 +1,69 @@
+#ifndef IO_H
+#define IO_H
+
+#include <stdint.h>
+#include "problem.h"
+
+// Position d'une erreur de format dans le fichier d'entrée (1-indexées)
+typedef struct {
+    int ligne;
+    int colonne;
+    char message[128];
+} ErreurLecture;
+
+// Charge une instance texte (même format que tests/ex*.txt) en projetant le
+// fichier en mémoire (mmap). Les lignes du tableau sont réparties sur
+// plusieurs threads pour les grosses instances.
+// Un fichier commençant par "creux n m k" décrit une instance creuse :
+// k lignes "i j cout" (arcs autorisés), puis les n provisions et les m commandes.
+// Un fichier commençant par "coordonnees n m L1|L2|L2R" décrit une instance à
+// coûts implicites : n lignes "x y P_i" puis m lignes "x y C_j".
+// Renvoie NULL en cas d'échec ; err (facultatif) décrit alors l'erreur.
+Probleme *charger_probleme_texte(const char *nom_fichier, ErreurLecture *err);
+
+// Lot d'instances de même forme (voir lot.h) : en-tête "lot k n m", puis
+// les k instances au format des exemples sans leur en-tête (n lignes de m
+// coûts suivis de la provision, puis les m commandes). Les coûts doivent
+// tenir dans [-LOT_COUT_MAX, LOT_COUT_MAX].
+struct LotProblemes *charger_lot_texte(const char *nom_fichier, ErreurLecture *err);
+
+/*
+ * Format binaire (version 1), tout en ordre d'octets natif :
+ *   - en-tête de 64 octets (EnTeteBinaire)
+ *   - provisions : n entiers 32 bits, puis bourrage jusqu'à 64 octets
+ *   - commandes  : m entiers 32 bits, puis bourrage jusqu'à 64 octets
+ *   - coûts      : n lignes de `pas` éléments de `largeur` octets (2, 4 ou 8)
+ * Les lignes de coûts ont la même disposition alignée qu'en mémoire, ce qui
+ * permet de projeter le fichier directement dans un Probleme sans copie.
+ */
+#define MAGIE_BINAIRE     "TRPB"
+#define VERSION_BINAIRE   1
+#define ORDRE_OCTETS      0x01020304u
+
+typedef struct {
+    char magie[4];
+    uint32_t version;
+    uint32_t ordre_octets;       // ORDRE_OCTETS, pour détecter un boutisme différent
+    uint32_t nb_fournisseurs;
+    uint32_t nb_clients;
+    uint32_t largeur;            // taille d'un coût en octets
+    uint32_t pas;                // éléments par ligne de coûts
+    uint32_t reserve;
+    uint64_t offset_provisions;
+    uint64_t offset_commandes;
+    uint64_t offset_couts;
+    uint64_t taille_totale;
+} EnTeteBinaire;
+
+// 1 si le fichier commence par la signature du format binaire
+int est_fichier_binaire(const char *nom_fichier);
+
+// Projette un fichier binaire (mmap) : couts, provisions et commandes
+// pointent directement dans le fichier, sans copie.
+Probleme *charger_probleme_binaire(const char *nom_fichier, ErreurLecture *err);
+
+// Écritures ; renvoient 0 si tout s'est bien passé
+int ecrire_probleme_binaire(const Probleme *p, const char *nom_fichier);
+int ecrire_probleme_texte(const Probleme *p, const char *nom_fichier);
+
+#endif
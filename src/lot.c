@@ -0,0 +1,374 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "lot.h"
+#include "couts_simd.h"
+
+LotProblemes *creer_lot(int nb, int n, int m)
+{
+    if (nb < 0 || n < 1 || m < 1 || n > PETIT_MAX || m > PETIT_MAX)
+        return NULL;
+
+    LotProblemes *l = calloc(1, sizeof(LotProblemes));
+    if (!l)
+        return NULL;
+    l->nb_instances = nb;
+    l->nb_fournisseurs = n;
+    l->nb_clients = m;
+    // + 1 : calloc(0) peut renvoyer NULL
+    l->couts = calloc((size_t)nb * n * m + 1, sizeof(int));
+    l->provisions = calloc((size_t)nb * n + 1, sizeof(int));
+    l->commandes = calloc((size_t)nb * m + 1, sizeof(int));
+    if (!l->couts || !l->provisions || !l->commandes) {
+        liberer_lot(l);
+        return NULL;
+    }
+    return l;
+}
+
+void liberer_lot(LotProblemes *l)
+{
+    if (!l)
+        return;
+    free(l->couts);
+    free(l->provisions);
+    free(l->commandes);
+    free(l);
+}
+
+void extraire_instance(const LotProblemes *l, int k, PetitProbleme *pp)
+{
+    int n = l->nb_fournisseurs, m = l->nb_clients;
+    const int *c = l->couts + (size_t)k * n * m;
+
+    pp->nb_fournisseurs = n;
+    pp->nb_clients = m;
+    for (int i = 0; i < n; i++) {
+        pp->provisions[i] = l->provisions[(size_t)k * n + i];
+        for (int j = 0; j < m; j++)
+            pp->couts[i][j] = c[i * m + j];
+    }
+    for (int j = 0; j < m; j++)
+        pp->commandes[j] = l->commandes[(size_t)k * m + j];
+}
+
+static int est_equilibree(const LotProblemes *l, int k)
+{
+    long long offre = 0, demande = 0;
+    for (int i = 0; i < l->nb_fournisseurs; i++)
+        offre += l->provisions[(size_t)k * l->nb_fournisseurs + i];
+    for (int j = 0; j < l->nb_clients; j++)
+        demande += l->commandes[(size_t)k * l->nb_clients + j];
+    return offre == demande;
+}
+
+/*
+ * Groupe de LOT_VOIES instances : la voie k de chaque vecteur appartient à
+ * la k-ième. Les vecteurs (extension de GCC) sont découpés par le
+ * compilateur selon la cible : un registre AVX2, ou deux registres SSE2.
+ * Un masque vaut -1 (vrai) ou 0 par voie, comme les comparaisons.
+ */
+
+typedef int32_t Voies __attribute__((vector_size(4 * LOT_VOIES)));
+
+typedef struct {
+    Voies couts[PETIT_MAX][PETIT_MAX];
+    Voies flux[PETIT_MAX][PETIT_MAX];
+    Voies provisions[PETIT_MAX];     // restes de Nord-Ouest
+    Voies commandes[PETIT_MAX];
+    Voies base_l[PETIT_MAX];         // colonnes de base de chaque ligne (bit j)
+    Voies base_c[PETIT_MAX];         // lignes de base de chaque colonne (bit i)
+    Voies u[PETIT_MAX], v[PETIT_MAX];
+    Voies cote_l, cote_c;            // lignes et colonnes dont les potentiels bougent
+    Voies decalage;                  // ... de + decalage (lignes), - decalage (colonnes)
+    Voies passes;                    // passes de tarification de chaque voie
+} Groupe;
+
+// Masque passé par adresse : un vecteur de 32 octets passé par valeur n'a
+// pas la même convention d'appel avec et sans AVX
+static int une_voie(const Voies *masque)
+{
+    for (int k = 0; k < LOT_VOIES; k++)
+        if ((*masque)[k])
+            return 1;
+    return 0;
+}
+
+/*
+ * Pivot de la voie k, arc entrant (ie, je) de coût marginal d < 0. Parcours
+ * en largeur de l'arbre depuis la ligne ie sur les masques de la base,
+ * jusqu'à la colonne je ; le cycle est le chemin des pères de je à ie. Signe
+ * - aux rangs pairs, + sinon, comme le chemin de l'arbre de optimiser_petit :
+ * même arc sortant à égalité.
+ *
+ * Sans l'arc sortant, l'arbre se coupe en deux ; seul le côté qui ne contient
+ * pas la ligne 0 (u_0 = 0) change de potentiels, de sorte que l'arc entrant
+ * ait un coût marginal nul. Ce côté et le décalage sont notés dans le groupe.
+ */
+static void pivoter(Groupe *g, int n, int m, int k, int ie, int je, int d)
+{
+    int pere_l[PETIT_MAX], pere_c[PETIT_MAX], file[2 * PETIT_MAX];
+    uint32_t vus_l = 1u << ie, vus_c = 0;
+    int tete = 0, queue = 0;
+    file[queue++] = ie;
+    while (!(vus_c & (1u << je))) {
+        int e = file[tete++];
+        if (e < PETIT_MAX) {
+            uint32_t nouveaux = (uint32_t)g->base_l[e][k] & ~vus_c;
+            vus_c |= nouveaux;
+            while (nouveaux) {
+                int j = __builtin_ctz(nouveaux);
+                nouveaux &= nouveaux - 1;
+                pere_c[j] = e;
+                file[queue++] = PETIT_MAX + j;
+            }
+        } else {
+            uint32_t nouveaux = (uint32_t)g->base_c[e - PETIT_MAX][k] & ~vus_l;
+            vus_l |= nouveaux;
+            while (nouveaux) {
+                int i = __builtin_ctz(nouveaux);
+                nouveaux &= nouveaux - 1;
+                pere_l[i] = e - PETIT_MAX;
+                file[queue++] = i;
+            }
+        }
+    }
+
+    int cycle_i[2 * PETIT_MAX], cycle_j[2 * PETIT_MAX];
+    int nb = 0, i, j = je;
+    for (;;) {
+        i = pere_c[j];
+        cycle_i[nb] = i; cycle_j[nb] = j; nb++;
+        if (i == ie)
+            break;
+        j = pere_l[i];
+        cycle_i[nb] = i; cycle_j[nb] = j; nb++;
+    }
+
+    int theta = -1, sortie = 0;
+    for (int r = 0; r < nb; r += 2) {
+        int x = g->flux[cycle_i[r]][cycle_j[r]][k];
+        if (theta < 0 || x < theta) {
+            theta = x;
+            sortie = r;
+        }
+    }
+
+    g->flux[ie][je][k] += theta;
+    for (int r = 0; r < nb; r++)
+        g->flux[cycle_i[r]][cycle_j[r]][k] += (r % 2 == 0) ? -theta : theta;
+
+    int is = cycle_i[sortie], js = cycle_j[sortie];
+    g->base_l[is][k] &= ~(1 << js);
+    g->base_c[js][k] &= ~(1 << is);
+
+    // Côté de la ligne 0, arc sortant retiré
+    vus_l = 1;
+    vus_c = 0;
+    tete = queue = 0;
+    file[queue++] = 0;
+    while (tete < queue) {
+        int e = file[tete++];
+        if (e < PETIT_MAX) {
+            uint32_t nouveaux = (uint32_t)g->base_l[e][k] & ~vus_c;
+            vus_c |= nouveaux;
+            while (nouveaux) {
+                file[queue++] = PETIT_MAX + __builtin_ctz(nouveaux);
+                nouveaux &= nouveaux - 1;
+            }
+        } else {
+            uint32_t nouveaux = (uint32_t)g->base_c[e - PETIT_MAX][k] & ~vus_l;
+            vus_l |= nouveaux;
+            while (nouveaux) {
+                file[queue++] = __builtin_ctz(nouveaux);
+                nouveaux &= nouveaux - 1;
+            }
+        }
+    }
+    g->cote_l[k] = (int32_t)(~vus_l & ((1u << n) - 1));
+    g->cote_c[k] = (int32_t)(~vus_c & ((1u << m) - 1));
+    g->decalage[k] = (vus_l & (1u << ie)) ? -d : d;
+
+    g->base_l[ie][k] |= 1 << je;
+    g->base_c[je][k] |= 1 << ie;
+}
+
+/*
+ * Noyau d'un groupe, généré pour la cible par défaut et pour AVX2.
+ *
+ * Nord-Ouest avance toutes les voies du même pas : sur un problème
+ * équilibré, le chemin en escalier compte toujours n + m - 1 cases. La case
+ * courante de chaque voie est repérée par des masques de ligne et de
+ * colonne, ce qui évite tout accès indexé par voie.
+ *
+ * Potentiels : u_0 = 0, puis mis à jour après chaque pivot (côté coupé de
+ * l'arbre) au lieu d'être recalculés. Tarification : minimum strict par
+ * voie dans l'ordre des cases, d'où la première case à égalité.
+ */
+#define DEFINIR_GROUPE(SUFFIXE, ATTRIBUT)                                           \
+ATTRIBUT static void resoudre_groupe_##SUFFIXE(Groupe *g, int n, int m)             \
+{                                                                                   \
+    const Voies zero = { 0 };                                                       \
+                                                                                    \
+    /* Nord-Ouest */                                                                \
+    Voies ligne = zero, colonne = zero;                                             \
+    for (int i = 0; i < n; i++) {                                                   \
+        g->base_l[i] = zero;                                                        \
+        for (int j = 0; j < m; j++)                                                 \
+            g->flux[i][j] = zero;                                                   \
+    }                                                                               \
+    for (int j = 0; j < m; j++)                                                     \
+        g->base_c[j] = zero;                                                        \
+    for (int pas = 0; pas < n + m - 1; pas++) {                                     \
+        Voies ici_l[PETIT_MAX], ici_c[PETIT_MAX];                                   \
+        Voies reste_p = zero, reste_c = zero;                                       \
+        for (int i = 0; i < n; i++) {                                               \
+            ici_l[i] = (ligne == i);                                                \
+            reste_p |= ici_l[i] & g->provisions[i];                                 \
+        }                                                                           \
+        for (int j = 0; j < m; j++) {                                               \
+            ici_c[j] = (colonne == j);                                              \
+            reste_c |= ici_c[j] & g->commandes[j];                                  \
+        }                                                                           \
+        Voies moins = (reste_p < reste_c);                                          \
+        Voies q = (moins & reste_p) | (~moins & reste_c);                           \
+        for (int i = 0; i < n; i++) {                                               \
+            g->provisions[i] -= ici_l[i] & q;                                       \
+            g->base_l[i] |= ici_l[i] & (1 << colonne);                              \
+            for (int j = 0; j < m; j++)                                             \
+                g->flux[i][j] |= ici_l[i] & ici_c[j] & q;                           \
+        }                                                                           \
+        for (int j = 0; j < m; j++) {                                               \
+            g->commandes[j] -= ici_c[j] & q;                                        \
+            g->base_c[j] |= ici_c[j] & (1 << ligne);                                \
+        }                                                                           \
+        Voies fin_p = (reste_p == q), fin_c = (reste_c == q);                       \
+        Voies bas = fin_p & (ligne + 1 < n);                                        \
+        Voies droite = ~bas & fin_c & (colonne + 1 < m);                            \
+        Voies autre = ~bas & ~droite;                                               \
+        ligne -= bas | (autre & fin_p);                                             \
+        colonne -= droite | (autre & fin_c);                                        \
+    }                                                                               \
+                                                                                    \
+    /* Potentiels de l'escalier : ses cases, dans l'ordre des lignes, */         \
+    /* touchent toujours une ligne ou une colonne déjà vue (un balayage) */        \
+    Voies connu_u[PETIT_MAX], connu_v[PETIT_MAX];                                   \
+    for (int i = 0; i < n; i++) {                                                   \
+        g->u[i] = zero;                                                             \
+        connu_u[i] = (i == 0) ? ~zero : zero;                                       \
+    }                                                                               \
+    for (int j = 0; j < m; j++)                                                     \
+        g->v[j] = connu_v[j] = zero;                                                \
+    for (int i = 0; i < n; i++)                                                     \
+        for (int j = 0; j < m; j++) {                                               \
+            Voies b = -((g->base_l[i] >> j) & 1);                                   \
+            Voies pour_v = b & connu_u[i] & ~connu_v[j];                            \
+            g->v[j] |= pour_v & (g->couts[i][j] - g->u[i]);                         \
+            connu_v[j] |= pour_v;                                                   \
+            Voies pour_u = b & connu_v[j] & ~connu_u[i];                            \
+            g->u[i] |= pour_u & (g->couts[i][j] - g->v[j]);                         \
+            connu_u[i] |= pour_u;                                                   \
+        }                                                                           \
+                                                                                    \
+    Voies actif = (zero == 0);                                                      \
+    g->passes = zero;                                                               \
+    const int iteration_max = 2 * n * m;   /* borne de sécurité */                  \
+    for (int iteration = 0; iteration < iteration_max && une_voie(&actif);          \
+         iteration++) {                                                             \
+        g->passes -= actif;                                                         \
+                                                                                    \
+        /* Tarification */                                                          \
+        Voies meilleur = zero, case_min = zero;                                     \
+        for (int i = 0; i < n; i++)                                                 \
+            for (int j = 0; j < m; j++) {                                           \
+                Voies d = g->couts[i][j] - g->u[i] - g->v[j];                       \
+                Voies lt = (d < meilleur);                                          \
+                meilleur = (lt & d) | (~lt & meilleur);                             \
+                case_min = (lt & (i * PETIT_MAX + j)) | (~lt & case_min);           \
+            }                                                                       \
+        actif &= (meilleur < 0);                                                    \
+                                                                                    \
+        /* Pivots, puis potentiels du côté coupé de chaque arbre */                 \
+        g->cote_l = g->cote_c = zero;                                               \
+        for (int k = 0; k < LOT_VOIES; k++)                                         \
+            if (actif[k])                                                           \
+                pivoter(g, n, m, k, case_min[k] / PETIT_MAX, case_min[k] % PETIT_MAX, \
+                        meilleur[k]);                                               \
+        for (int i = 0; i < n; i++)                                                 \
+            g->u[i] += -((g->cote_l >> i) & 1) & g->decalage;                       \
+        for (int j = 0; j < m; j++)                                                 \
+            g->v[j] -= -((g->cote_c >> j) & 1) & g->decalage;                       \
+    }                                                                               \
+    /* Voies encore actives à la borne : pas de preuve d'optimalité, -2 */          \
+    g->passes = (actif & (zero - 2)) | (~actif & g->passes);                        \
+}
+
+DEFINIR_GROUPE(defaut, )
+#if COUTS_SIMD
+DEFINIR_GROUPE(avx2, __attribute__((target("avx2"))))
+#endif
+
+int resoudre_lot(const LotProblemes *l, long long *couts_optimaux, int *iterations)
+{
+    int n = l->nb_fournisseurs, m = l->nb_clients;
+    int *valides = malloc(((size_t)l->nb_instances + 1) * sizeof(int));
+    Groupe *g = aligned_alloc(sizeof(Voies), sizeof(Groupe));
+    if (!valides || !g) {
+        free(valides);
+        free(g);
+        return 0;
+    }
+
+    // Les instances déséquilibrées sont écartées des groupes
+    int nb_valides = 0;
+    for (int k = 0; k < l->nb_instances; k++) {
+        if (est_equilibree(l, k)) {
+            valides[nb_valides++] = k;
+        } else {
+            couts_optimaux[k] = 0;
+            iterations[k] = -1;
+        }
+    }
+
+    int avx2 = simd_disponible();
+    int nb_bornees = 0;   // voies arrêtées par la borne de passes
+    for (int premier = 0; premier < nb_valides; premier += LOT_VOIES) {
+        // Voies sans instance : copies de la première, résultats ignorés
+        int membres[LOT_VOIES];
+        for (int v = 0; v < LOT_VOIES; v++)
+            membres[v] = valides[(premier + v < nb_valides) ? premier + v : premier];
+
+        for (int v = 0; v < LOT_VOIES; v++) {
+            int k = membres[v];
+            const int *c = l->couts + (size_t)k * n * m;
+            for (int i = 0; i < n; i++) {
+                g->provisions[i][v] = l->provisions[(size_t)k * n + i];
+                for (int j = 0; j < m; j++)
+                    g->couts[i][j][v] = c[i * m + j];
+            }
+            for (int j = 0; j < m; j++)
+                g->commandes[j][v] = l->commandes[(size_t)k * m + j];
+        }
+
+#if COUTS_SIMD
+        if (avx2)
+            resoudre_groupe_avx2(g, n, m);
+        else
+#endif
+            resoudre_groupe_defaut(g, n, m);
+
+        for (int v = 0; v < LOT_VOIES && premier + v < nb_valides; v++) {
+            long long total = 0;
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < m; j++)
+                    total += (long long)g->couts[i][j][v] * g->flux[i][j][v];
+            couts_optimaux[membres[v]] = total;
+            iterations[membres[v]] = g->passes[v];
+            nb_bornees += (g->passes[v] < 0);
+        }
+    }
+    (void)avx2;
+
+    free(valides);
+    free(g);
+    return nb_valides - nb_bornees;
+}
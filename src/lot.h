@@ -0,0 +1,53 @@
+#ifndef LOT_H
+#define LOT_H
+
+#include "petit_probleme.h"
+
+/*
+ * Résolution par lots de petites instances de même forme (n x m <= PETIT_MAX),
+ * par exemple 64 instances 5 x 5. Les instances sont groupées par LOT_VOIES :
+ * chaque case (i, j) d'un groupe est un vecteur dont la voie k appartient à
+ * la k-ième instance (structure de tableaux entre instances). Coûts, flux,
+ * potentiels et tarification se calculent ainsi une fois pour tout le
+ * groupe ; une voie dont l'instance est optimale est masquée et ne fait plus
+ * que suivre les autres. Seul le pivot (cycle, quantité échangée) reste
+ * scalaire, voie par voie.
+ *
+ * Mêmes règles que le chemin rapide (petit_probleme.h) : Nord-Ouest, puis
+ * tarification de Dantzig (première case à égalité), d'où les mêmes coûts
+ * optimaux. Les nombres de passes ne diffèrent que si Nord-Ouest est
+ * dégénéré : la base du lot garde alors les cases nulles de l'escalier, là
+ * où optimiser_petit complète la base dans l'ordre des cases.
+ *
+ * Les potentiels tiennent sur 32 bits tant que |coût| <= LOT_COUT_MAX
+ * (|u_i|, |v_j| <= (n + m) x LOT_COUT_MAX) ; la lecture refuse les autres.
+ */
+
+#define LOT_VOIES    8
+#define LOT_COUT_MAX (1 << 24)
+
+typedef struct LotProblemes {
+    int nb_instances;
+    int nb_fournisseurs;
+    int nb_clients;
+    int *couts;          // instance k : n x m coûts en k * n * m, ligne par ligne
+    int *provisions;     // instance k : n provisions en k * n
+    int *commandes;      // instance k : m commandes en k * m
+} LotProblemes;
+
+// Lot de nb instances n x m aux données nulles, ou NULL (dimensions hors
+// de 1..PETIT_MAX, mémoire insuffisante)
+LotProblemes *creer_lot(int nb, int n, int m);
+void liberer_lot(LotProblemes *l);
+
+// Résout toutes les instances : coût optimal et nombre de passes de
+// tarification de chacune (-1 pour une instance déséquilibrée, ignorée ;
+// -2 si la borne de 2·n·m passes est atteinte avant l'optimalité, le coût
+// est alors celui d'une solution réalisable). Renvoie le nombre
+// d'instances résolues.
+int resoudre_lot(const LotProblemes *l, long long *couts_optimaux, int *iterations);
+
+// Une instance du lot sous la forme du chemin rapide (vérification)
+void extraire_instance(const LotProblemes *l, int k, PetitProbleme *pp);
+
+#endif
@@ -1,26 +1,104 @@
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
 #include <stdlib.h>
 #include <stdarg.h>
-#include "problem.h"
-#include "nord_ouest.h"
-#include "balas_hammer.h"
-#include "potentiel.h"
-#include "marche_pied.h"
-#include "base.h"
+#include "transport.h"
 #include "trace.h"
+#include "io.h"
+#include "tuiles.h"
+#include "heuristiques.h"
+
+// Noms des méthodes initiales du registre, séparés par sep
+static void noms_methodes(char *tampon, size_t taille, const char *sep)
+{
+    tampon[0] = '\0';
+    for (int k = 0; k < nb_heuristiques(); k++) {
+        size_t l = strlen(tampon);
+        snprintf(tampon + l, taille - l, "%s%s", k ? sep : "", heuristique(k)->nom);
+    }
+}
+
+// transport convert <entrée> <sortie> : texte -> binaire, ou binaire -> texte
+static int convertir(const char *entree, const char *sortie)
+{
+    int vers_texte = est_fichier_binaire(entree);
+
+    Probleme *p = lire_probleme(entree);
+    if (!p) {
+        trace("Erreur : impossible de lire le fichier.\n");
+        return 1;
+    }
+
+    int res = vers_texte ? ecrire_probleme_texte(p, sortie)
+                         : ecrire_probleme_binaire(p, sortie);
+    if (res != 0)
+        trace("Erreur : impossible d'écrire %s.\n", sortie);
+    else
+        trace("%s -> %s (%s)\n", entree, sortie, vers_texte ? "texte" : "binaire");
+
+    liberer_probleme(p);
+    return (res != 0);
+}
 
 int main(int argc, char **argv)
 {
 
+    if (argc >= 2 && strcmp(argv[1], "convert") == 0) {
+        if (argc < 4) {
+            trace("Usage : %s convert <entrée> <sortie>\n", argv[0]);
+            return 1;
+        }
+        return convertir(argv[2], argv[3]);
+    }
+
+    char methodes[256];
+
     if (argc < 3) {
-        trace("Usage : %s <fichier.txt> <no|bh>\n", argv[0]);
+        noms_methodes(methodes, sizeof(methodes), "|");
+        trace("Usage : %s <fichier.txt|fichier.bin> <%s|auto> [--tuiles <Kio>] [--threads <n>]\n"
+              "        [--table <fichier>] [--presolve] [--tarification <dantzig|blocs|candidats>]\n",
+              argv[0], methodes);
+        trace("        %s <fichier.txt|fichier.bin> --portfolio [--delai <ms>] [--tuiles <Kio>]\n",
+              argv[0]);
+        trace("        %s convert <entrée> <sortie>\n", argv[0]);
         return 1;
     }
 
     const char *fichier = argv[1];
-    const char *methode = argv[2];
+    // --portfolio à la place de la méthode : toutes les méthodes en parallèle
+    const char *methode = (strcmp(argv[2], "--portfolio") == 0) ? TRANSPORT_PORTEFEUILLE : argv[2];
+
+    // --tuiles : lecture des coûts par tuiles (instances binaires plus grosses que la mémoire)
+    // --threads : threads de la méthode initiale (0 : un par cœur)
+    // --delai : portefeuille, délai maximal des méthodes les plus lentes
+    // --table : auto, table de décision (écrite par complexite --calibrer)
+    // --presolve : préresolution, que les traces détaillées n'appliquent pas
+    //              d'office (elles montrent alors le problème réduit)
+    // --tarification : choix de l'arc entrant du marche-pied (dantzig par défaut)
+    size_t taille_tuile = 0;
+    int nb_threads = 1;
+    double delai = 0;
+    int preresolution = 0;
+    const char *tarification = NULL;
+    const char *table = NULL;
+    for (int a = 3; a < argc; a++) {
+        if (strcmp(argv[a], "--tuiles") == 0 && a + 1 < argc) {
+            taille_tuile = (size_t)strtoul(argv[++a], NULL, 10) * 1024;
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            nb_threads = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--delai") == 0 && a + 1 < argc) {
+            delai = atof(argv[++a]) / 1000.0;
+        } else if (strcmp(argv[a], "--presolve") == 0) {
+            preresolution = 1;
+        } else if (strcmp(argv[a], "--tarification") == 0 && a + 1 < argc) {
+            tarification = argv[++a];
+        } else if (strcmp(argv[a], "--table") == 0 && a + 1 < argc) {
+            table = argv[++a];
+        } else {
+            trace("Option inconnue : %s\n", argv[a]);
+            return 1;
+        }
+    }
 
     Probleme *p = lire_probleme(fichier);
     if (!p) {
@@ -28,6 +106,9 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    if (taille_tuile > 0 && activer_tuilage(p, taille_tuile) != 0)
+        trace("Lecture par tuiles ignorée : matrice de coûts non dense.\n");
+
     char *fichier_modifie = malloc(strlen(fichier) - 11); 
     strncpy(fichier_modifie, fichier + 8, strlen(fichier) - 12); 
     fichier_modifie[strlen(fichier) - 12] = '\0';
@@ -35,151 +116,90 @@ int main(int argc, char **argv)
     char trace_filename[256];
     snprintf(trace_filename, sizeof(trace_filename), "traces_tests/NEW1-1-trace%s-%s.txt", fichier_modifie, methode);
 
-    trace_file = fopen(trace_filename, "w");
-    if (!trace_file) {
+    FILE *fichier_trace = fopen(trace_filename, "w");
+    if (!fichier_trace) {
         perror("Erreur trace");
         return 1;
     }
 
-    afficher_probleme(p);
-
-    Solution *s = creer_solution_vide(p);
+    SortieTrace sortie = { 1, fichier_trace };
+    trace_rediriger(sortie);
 
-    clock_t start;
-    clock_t end;
+    afficher_probleme(p);
 
-    if (strcmp(methode, "no") == 0) {
-        trace("\n=== MÉTHODE : NORD-OUEST ===\n");
-        start = clock();
-        coin_nord_ouest(p, s);
-        end = clock();
+    ContexteTransport *ctx = transport_creer_contexte();
+    if (!ctx) {
+        trace("Erreur : mémoire insuffisante.\n");
+        liberer_probleme(p);
+        return 1;
     }
-    else if (strcmp(methode, "bh") == 0) {
-        trace("\n=== MÉTHODE : BALAS-HAMMER ===\n");
-        start = clock();
-        balas_hammer(p, s);
-        end = clock();
+    transport_definir_traces(ctx, sortie.console, sortie.fichier);
+    transport_definir_detail(ctx, 1);
+    transport_definir_threads(ctx, nb_threads);
+    transport_definir_delai_portefeuille(ctx, delai);
+    transport_definir_preresolution(ctx, preresolution);
+    if (table && transport_charger_table_choix(ctx, table) != TRANSPORT_OK) {
+        trace("Table de décision illisible : %s\n", table);
+        transport_detruire_contexte(ctx);
+        liberer_probleme(p);
+        return 1;
     }
-    else {
-        trace("Méthode inconnue (utiliser 'no' ou 'bh').\n");
+    if (tarification && transport_definir_tarification(ctx, tarification) != TRANSPORT_OK) {
+        trace("Tarification inconnue (utiliser 'dantzig', 'blocs' ou 'candidats').\n");
+        transport_detruire_contexte(ctx);
         liberer_probleme(p);
-        liberer_solution(s);
         return 1;
     }
 
-    double time_spent_methode = (double)(end - start) / CLOCKS_PER_SEC;
-
-    trace("\n=== SOLUTION DE DÉPART ===\n");
-    afficher_solution(p, s);
-
-    // === Construction initiale de la base ===
-    Base *b = construire_base(s);
-
-    //  Potentiels + coûts marginaux + marche-pied (boucle complète)
-    int pot_f[p->nb_fournisseurs];
-    int pot_c[p->nb_clients];
-
-    int i_entree, j_entree;
-    int i_sortie, j_sortie;
-    int optimal = 0;
-    int iteration = 1;
-    double time_spent_mp=0.0;
-
-    // c'est pas bon ici je pense 
-    while (1) {
-        trace("\n================== ITERATION %d ==================\n", iteration++);
-
-        // (Re)affichage de la base courante
-        afficher_base_liste(b);  // debug textuel
-        afficher_base_graphe(b, p->nb_fournisseurs, p->nb_clients);  // dessin style S/T
-
-        // Vérification/correction de la base à chaque itération pour que les potentiels soient cohérents
-        if (base_est_arbre(b, p->nb_fournisseurs, p->nb_clients)) {
-            trace("\n>>> La base est un arbre. OK pour les potentiels.\n");
-        } else {
-            trace("\n>>> La base n'est PAS un arbre ! Correction nécessaire.\n");
-            trace("\n>>> Correction automatique de la base...\n");
-
-            Base *b2 = corriger_base(b, s,
-                                     p->nb_fournisseurs,
-                                     p->nb_clients);
-
-            liberer_base(b);
-            b = b2;
-
-            trace("\n--- Nouvelle base après correction ---\n");
-            afficher_base_liste(b);
-            afficher_base_graphe(b,
-                                 p->nb_fournisseurs,
-                                 p->nb_clients);
-        }
-
-        // 1) Potentiels
-        calculer_potentiels(p, b, pot_f, pot_c);
-        afficher_potentiels(p, pot_f, pot_c);
-        afficher_table_couts_potentiels(p, pot_f, pot_c);
-
-        // 2) Coûts marginaux + choix de l'arête améliorante
-        optimal = calculer_et_afficher_couts_marginaux(p, s, b,
-                                                       pot_f, pot_c,
-                                                       &i_entree, &j_entree);
-
-        
-
-        // 3) Marche-pied si ce n'est pas optimal
-        if (!optimal) {
-            trace("\n=== MARCHE-PIED SUR L'ARÊTE AMÉLIORANTE (F%d, C%d) ===\n",
-                   i_entree, j_entree);
-            start = clock();
-            i_sortie = -1;
-            j_sortie = -1;
-            int theta_mp = marche_pied(b, s, i_entree, j_entree, &i_sortie, &j_sortie);
-            end = clock();
-
-            trace("\n=== NOUVELLE SOLUTION APRÈS MARCHE-PIED ===\n");
-            afficher_solution(p, s);
-
-            time_spent_mp += (double)(end - start) / CLOCKS_PER_SEC;
-
-            if (theta_mp == 0) {
-                trace("Pivot dégénéré (theta = 0) : mise à jour de la base pour changer de proposition.\n");
-            }
-
-            // Mettre à jour la base en remplaçant l'arc sortant par l'arc entrant,
-            // même en cas de pivot dégénéré (theta = 0) pour éviter de boucler.
-            int remplace = 0;
-            if (i_sortie >= 0 && j_sortie >= 0) {
-                for (int k = 0; k < b->nb_arcs; k++) {
-                    if (b->arcs[k][0] == i_sortie && b->arcs[k][1] == j_sortie) {
-                        b->arcs[k][0] = i_entree;
-                        b->arcs[k][1] = j_entree;
-                        remplace = 1;
-                        break;
-                    }
-                }
-            }
-
-            if (!remplace) {
-                trace("Avertissement : base non mise à jour (arc sortant introuvable). Reconstruction.\n");
-                liberer_base(b);
-                b = construire_base(s);
-            }
-        } else {
-            trace("\n=== SOLUTION DÉJÀ OPTIMALE, PAS DE MARCHE-PIED ===\n");
-            break;
-        }
+    ResultatTransport res;
+    int statut = transport_solve(ctx, p, methode, &res);
+    if (statut == TRANSPORT_METHODE_INCONNUE) {
+        noms_methodes(methodes, sizeof(methodes), "', '");
+        trace("Méthode inconnue (utiliser '%s', 'auto' ou --portfolio).\n", methodes);
+        transport_detruire_contexte(ctx);
+        liberer_probleme(p);
+        return 1;
+    }
+    if (statut != TRANSPORT_OK) {
+        trace(statut == TRANSPORT_ECHEANCE
+                  ? "Erreur : aucune méthode n'a abouti avant le délai (--delai).\n"
+                  : "Erreur : mémoire insuffisante.\n");
+        transport_detruire_contexte(ctx);
+        liberer_probleme(p);
+        return 1;
+    }
 
+    const Solution *s = res.solution;
+
+    // Variante creuse : un flux restant sur une paire interdite signale une instance irréalisable
+    if (est_creux(p)) {
+        int nb_artificiels = 0;
+        for (int k = 0; k < s->nb_cases; k++)
+            if (s->flux[k] > 0 && !arc_autorise(p, s->case_i[k], s->case_j[k]))
+                nb_artificiels++;
+        if (nb_artificiels > 0)
+            trace("\nAttention : %d arc(s) artificiel(s) transportent encore du flux : "
+                  "l'instance n'est pas réalisable sur les seuls arcs autorisés.\n", nb_artificiels);
     }
 
+    trace("\nCoût total de la proposition finale : %lld\n", res.cout_total);
+    if (p->tuilage)
+        trace("Octets de coûts lus par tuiles : %llu\n", octets_lus_couts(p));
+
     trace("\n=== Meusure du temps ===\n");
-    trace("Temps méthode initiale (%s) : %.6f secondes\n", methode, time_spent_methode);
-    trace("Temps total marche-pied : %.6f secondes\n", time_spent_mp);
+    if (strcmp(methode, TRANSPORT_PORTEFEUILLE) == 0 || strcmp(methode, TRANSPORT_AUTO) == 0)
+        trace("Temps méthode initiale (%s, %s retenue) : %.6f secondes\n",
+              methode, res.methode, res.temps_initial);
+    else
+        trace("Temps méthode initiale (%s) : %.6f secondes\n", methode, res.temps_initial);
+    trace("Temps total marche-pied : %.6f secondes\n", res.temps_marche_pied);
+    if (tarification)
+        trace("Tarification %s : %d pivot(s)\n", tarification, res.nb_iterations - 1);
     trace("=============================================\n");
 
-    liberer_base(b);
+    transport_detruire_contexte(ctx);
     liberer_probleme(p);
-    liberer_solution(s);
-    fclose(trace_file);
+    fclose(fichier_trace);
 
     return 0;
 }
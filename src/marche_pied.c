@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <limits.h>
 #include "marche_pied.h"
 #include "trace.h"
@@ -7,15 +8,13 @@
 //  - Fournisseurs : 0 .. n-1
 //  - Clients      : n .. n+m-1  (client j ↦ n + j)
 
-// BFS pour trouver un chemin entre deux nœuds dans la base (qui est un arbre)
-static int trouver_chemin(const Base *b, int n, int m,
-                          int source, int cible, int parent[])
+// BFS pour trouver un chemin entre deux nœuds dans la base (qui est un arbre),
+// sur l'adjacence : chaque arc est vu au plus deux fois
+int trouver_chemin(const AdjacenceBase *adj, int source, int cible, int *parent, int *file)
 {
-    int total = n + m;
-    int file[64];   // suffisant pour nos petits exemples
     int tete = 0, queue = 0;
 
-    for (int i = 0; i < total; i++)
+    for (int i = 0; i < adj->nb_sommets; i++)
         parent[i] = -1;
 
     file[queue++] = source;
@@ -24,18 +23,8 @@ static int trouver_chemin(const Base *b, int n, int m,
     while (tete < queue && parent[cible] == -1) {
         int u = file[tete++];
 
-        for (int k = 0; k < b->nb_arcs; k++) {
-            int fi = b->arcs[k][0];
-            int cj = b->arcs[k][1];
-
-            int a = fi;          // nœud fournisseur
-            int c = n + cj;      // nœud client
-
-            int v = -1;
-            if (u == a)      v = c;
-            else if (u == c) v = a;
-            else            continue;
-
+        for (int k = adj->debut[u]; k < adj->debut[u + 1]; k++) {
+            int v = adj->voisins[k];
             if (parent[v] == -1) {
                 parent[v] = u;
                 file[queue++] = v;
@@ -46,43 +35,66 @@ static int trouver_chemin(const Base *b, int n, int m,
     return (parent[cible] != -1);
 }
 
-int marche_pied(const Base *b, Solution *s,
-                int i_entree, int j_entree,
-                int *i_sortie_ptr, int *j_sortie_ptr)
+int chemin_du_cycle(const ArbreBase *t, const AdjacenceBase *adj,
+                    int i_entree, int j_entree, int *chemin, int *travail)
 {
-    int n = s->nb_fournisseurs;
-    int m = s->nb_clients;
-
-    int noeud_f = i_entree;      // fournisseur
-    int noeud_c = n + j_entree;  // client
-
-    int parent[64];
+    if (t && t->racine >= 0)
+        return cycle_arbre(t, i_entree, j_entree, chemin);
+    if (!adj)
+        return -1;
 
-    // 1) Trouver le chemin dans la base entre F_i_entree et C_j_entree
-    if (!trouver_chemin(b, n, m, noeud_f, noeud_c, parent)) {
-        trace("Erreur marche_pied : impossible de trouver un chemin entre F%d et C%d dans la base.\n",
-               i_entree, j_entree);
-        if (i_sortie_ptr) *i_sortie_ptr = -1;
-        if (j_sortie_ptr) *j_sortie_ptr = -1;
+    int n = adj->nb_fournisseurs;
+    int total = adj->nb_sommets;
+    int *parent = travail;
+    int *file = travail + total;
+    if (!trouver_chemin(adj, i_entree, n + j_entree, parent, file))
         return -1;
-    }
 
-    // 2) Reconstruire le chemin (suite de nœuds) de F -> C
-    int chemin_noeuds[64];
+    // Remontée de C vers F, puis inversion pour avoir F ... C
     int len = 0;
-    int cur = noeud_c;
-
+    int cur = n + j_entree;
     while (1) {
-        chemin_noeuds[len++] = cur;
-        if (cur == noeud_f) break;
+        chemin[len++] = cur;
+        if (cur == i_entree || len >= total) break;
         cur = parent[cur];
     }
-
-    // inverser pour avoir F ... C
     for (int i = 0; i < len / 2; i++) {
-        int tmp = chemin_noeuds[i];
-        chemin_noeuds[i] = chemin_noeuds[len - 1 - i];
-        chemin_noeuds[len - 1 - i] = tmp;
+        int tmp = chemin[i];
+        chemin[i] = chemin[len - 1 - i];
+        chemin[len - 1 - i] = tmp;
+    }
+    return len;
+}
+
+int marche_pied(const ArbreBase *t, const AdjacenceBase *adj, Solution *s,
+                int i_entree, int j_entree,
+                int *i_sortie_ptr, int *j_sortie_ptr)
+{
+    int n = s->nb_fournisseurs;
+    int total = n + s->nb_clients;
+
+    // Un seul bloc pour tous les tableaux de travail (taille n + m chacun)
+    int *travail = malloc(sizeof(int) * 6 * (size_t)total);
+    if (!travail) {
+        trace("Erreur marche_pied : mémoire insuffisante.\n");
+        if (i_sortie_ptr) *i_sortie_ptr = -1;
+        if (j_sortie_ptr) *j_sortie_ptr = -1;
+        return -1;
+    }
+    int *chemin_noeuds = travail;
+    int *cycle_i = travail + total;
+    int *cycle_j = travail + 2 * total;
+    int *signe = travail + 3 * total;
+    int theta = -1;
+
+    // 1-2) Chemin (suite de nœuds) de F_i_entree à C_j_entree dans la base
+    int len = chemin_du_cycle(t, adj, i_entree, j_entree, chemin_noeuds, travail + 4 * total);
+    if (len < 0) {
+        trace("Erreur marche_pied : impossible de trouver un chemin entre F%d et C%d dans la base.\n",
+               i_entree, j_entree);
+        if (i_sortie_ptr) *i_sortie_ptr = -1;
+        if (j_sortie_ptr) *j_sortie_ptr = -1;
+        goto fin;
     }
 
     // 3) Construire la liste des cases du cycle (i,j)
@@ -90,8 +102,6 @@ int marche_pied(const Base *b, Solution *s,
     //      - l’arc entrant (i_entree, j_entree)
     //      - tous les arcs du chemin F -> C, dans l’ordre
     int cycle_taille = len;  // nb d'arcs
-    int cycle_i[64];
-    int cycle_j[64];
 
     // arc 0 : arc entrant
     cycle_i[0] = i_entree;
@@ -116,7 +126,7 @@ int marche_pied(const Base *b, Solution *s,
             trace("Erreur marche_pied : chemin non biparti.\n");
             if (i_sortie_ptr) *i_sortie_ptr = -1;
             if (j_sortie_ptr) *j_sortie_ptr = -1;
-            return -1;
+            goto fin;
         }
 
         cycle_i[e + 1] = fi;
@@ -125,18 +135,17 @@ int marche_pied(const Base *b, Solution *s,
 
     // 4) Déterminer les signes (+/-) le long du cycle :
     //    + sur l’arc entrant, puis alternance
-    int signe[64];
     for (int e = 0; e < cycle_taille; e++) {
         signe[e] = (e % 2 == 0) ? +1 : -1;
     }
 
     // 5) Calcul de theta = min des x_ij sur les arcs marqués "−"
-    int theta = INT_MAX;
+    theta = INT_MAX;
     for (int e = 0; e < cycle_taille; e++) {
         if (signe[e] == -1) {
             int ii = cycle_i[e];
             int jj = cycle_j[e];
-            int x = s->x[ii][jj];
+            int x = sol_x(s, ii, jj);
             if (x < theta) theta = x;
         }
     }
@@ -145,7 +154,8 @@ int marche_pied(const Base *b, Solution *s,
         trace("Erreur marche_pied : aucun arc avec signe '-' dans le cycle.\n");
         if (i_sortie_ptr) *i_sortie_ptr = -1;
         if (j_sortie_ptr) *j_sortie_ptr = -1;
-        return -1;
+        theta = -1;
+        goto fin;
     }
 
     trace("\n--- Marche-pied pour l’arc entrant (%d,%d) ---\n", i_entree, j_entree);
@@ -160,7 +170,7 @@ int marche_pied(const Base *b, Solution *s,
     for (int e = 0; e < cycle_taille; e++) {
         int ii = cycle_i[e];
         int jj = cycle_j[e];
-        s->x[ii][jj] += signe[e] * theta;
+        sol_ajouter(s, ii, jj, signe[e] * theta);
     }
 
     // 7) Identifier l’arc sortant (celui qui tombe à 0 parmi les “−”)
@@ -169,7 +179,7 @@ int marche_pied(const Base *b, Solution *s,
         if (signe[e] == -1) {
             int ii = cycle_i[e];
             int jj = cycle_j[e];
-            if (s->x[ii][jj] == 0) {
+            if (sol_x(s, ii, jj) == 0) {
                 i_sortie = ii;
                 j_sortie = jj;
                 break;
@@ -186,5 +196,7 @@ int marche_pied(const Base *b, Solution *s,
         trace("Attention : aucun arc '-' n’est tombé à 0 (situation dégénérée).\n");
     }
 
+fin:
+    free(travail);
     return theta;
 }
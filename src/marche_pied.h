@@ -3,14 +3,27 @@
 
 #include "problem.h"
 #include "base.h"
+#include "arbre_base.h"
+
+// Chemin de source à cible dans l'arbre de la base (parcours en largeur sur
+// l'adjacence, O(n + m)) : parent[v] est le prédécesseur de v, parent[source]
+// vaut source. file : n + m entiers de travail. Renvoie 1 si cible est atteinte.
+int trouver_chemin(const AdjacenceBase *adj, int source, int cible, int *parent, int *file);
+
+// Chemin du cycle de l'arc entrant, de F_i_entree à C_j_entree : par l'arbre
+// enraciné t s'il est valide (O(longueur du cycle)), sinon par trouver_chemin
+// sur adj (peut être NULL si t est valide). chemin : n + m entiers,
+// travail : 2 x (n + m). Renvoie le nombre de sommets, -1 sans chemin.
+int chemin_du_cycle(const ArbreBase *t, const AdjacenceBase *adj,
+                    int i_entree, int j_entree, int *chemin, int *travail);
 
 // Applique un pas de marche-pied en utilisant l'arc entré (i_entree, j_entree)
-// b : base actuelle (arbre) utilisée pour trouver le cycle
+// t, adj : base actuelle enracinée et son adjacence, pour trouver le cycle
+// (voir chemin_du_cycle)
 // s : solution (matrice des quantités x_ij), modifiée en place
 // Renvoie theta (>=0) et, via pointeurs, l'arc sortant choisi
-int marche_pied(const Base *b, Solution *s,
+int marche_pied(const ArbreBase *t, const AdjacenceBase *adj, Solution *s,
                 int i_entree, int j_entree,
                 int *i_sortie, int *j_sortie);
 
-
 #endif
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "minimum_ligne.h"
+#include "couts.h"
+#include "trace.h"
+#include "annulation.h"
+
+static int minimum(int a, int b) { return (a < b) ? a : b; }
+
+/*
+ * Chaque remplissage raye une ligne ou une colonne : au plus n + m recherches
+ * de la colonne active la moins chère, chacune d'un balayage de ligne.
+ */
+
+void minimum_ligne(const Probleme *p, Solution *s)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    int *commandes = malloc((size_t)m * sizeof(int));
+    int *colonne_active = malloc((size_t)m * sizeof(int));
+    int *tampon = malloc((size_t)taille_tampon_couts(p) * sizeof(int));
+
+    if (!commandes || !colonne_active || !tampon) {
+        trace("Erreur minimum par ligne : mémoire insuffisante.\n");
+        goto fin;
+    }
+
+    trace("\n--- Déroulé de la méthode du minimum par ligne ---\n\n");
+
+    int nb_colonnes_actives = 0;
+    for (int j = 0; j < m; j++) {
+        commandes[j] = p->commandes[j];
+        colonne_active[j] = (commandes[j] > 0);
+        nb_colonnes_actives += colonne_active[j];
+    }
+
+    for (int i = 0; i < n && nb_colonnes_actives > 0; i++) {
+        int provision = p->provisions[i];
+
+        while (provision > 0 && !methode_annulee()) {
+            long long c;
+            int j = argmin_ligne_actif(p, i, colonne_active, tampon, &c);
+            if (j < 0)
+                break;
+
+            int q = minimum(provision, commandes[j]);
+            sol_fixer(s, i, j, q);
+
+            trace("Remplissage de la case (%d,%d) avec %d unités (coût %lld)\n",
+                   i, j, q, c);
+
+            provision -= q;
+            commandes[j] -= q;
+            if (commandes[j] == 0) {
+                colonne_active[j] = 0;
+                nb_colonnes_actives--;
+            }
+        }
+    }
+
+    trace("\n--- Fin de la méthode du minimum par ligne ---\n\n");
+
+fin:
+    free(commandes);
+    free(colonne_active);
+    free(tampon);
+}
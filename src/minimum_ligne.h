@@ -0,0 +1,11 @@
+#ifndef MINIMUM_LIGNE_H
+#define MINIMUM_LIGNE_H
+
+#include "problem.h"
+
+// Proposition initiale par la méthode du minimum par ligne : chaque ligne, dans
+// l'ordre, remplit ses colonnes actives par coût croissant jusqu'à épuisement
+// de sa provision.
+void minimum_ligne(const Probleme *p, Solution *s);
+
+#endif
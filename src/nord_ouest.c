@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "nord_ouest.h"
 #include "trace.h"
+#include "annulation.h"
 
 void coin_nord_ouest(const Probleme *p, Solution *s)
 {
@@ -17,10 +18,10 @@ void coin_nord_ouest(const Probleme *p, Solution *s)
 
     trace("\n--- Déroulé de la méthode du Coin Nord-Ouest ---\n");
 
-    while (i < p->nb_fournisseurs && j < p->nb_clients) {
+    while (i < p->nb_fournisseurs && j < p->nb_clients && !methode_annulee()) {
 
         int q = (provisions[i] < commandes[j]) ? provisions[i] : commandes[j];
-        s->x[i][j] = q;
+        sol_fixer(s, i, j, q);
 
         trace("Case (%d,%d) ← %d\n", i, j, q);
 
@@ -0,0 +1,262 @@
+#include <stdint.h>
+#include "petit_probleme.h"
+
+int charger_petit(const Probleme *p, PetitProbleme *pp)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    // Variante creuse : la tarification ne parcourt que les arcs autorisés
+    if (!est_petit(p) || est_creux(p) || p->tuilage)
+        return 0;
+
+    long long offre = 0, demande = 0;
+    for (int i = 0; i < n; i++)
+        offre += p->provisions[i];
+    for (int j = 0; j < m; j++)
+        demande += p->commandes[j];
+    if (offre != demande)
+        return 0;
+
+    pp->nb_fournisseurs = n;
+    pp->nb_clients = m;
+    for (int i = 0; i < n; i++) {
+        pp->provisions[i] = p->provisions[i];
+        for (int j = 0; j < m; j++)
+            pp->couts[i][j] = cout_arc(p, i, j);
+    }
+    for (int j = 0; j < m; j++)
+        pp->commandes[j] = p->commandes[j];
+    return 1;
+}
+
+void nord_ouest_petit(const PetitProbleme *pp, FluxPetit flux)
+{
+    int n = pp->nb_fournisseurs, m = pp->nb_clients;
+    int provisions[PETIT_MAX], commandes[PETIT_MAX];
+    for (int i = 0; i < n; i++) {
+        provisions[i] = pp->provisions[i];
+        for (int j = 0; j < m; j++)
+            flux[i][j] = 0;
+    }
+    for (int j = 0; j < m; j++)
+        commandes[j] = pp->commandes[j];
+
+    int i = 0, j = 0;
+    while (i < n && j < m) {
+        int q = (provisions[i] < commandes[j]) ? provisions[i] : commandes[j];
+        flux[i][j] = q;
+        provisions[i] -= q;
+        commandes[j] -= q;
+
+        if (provisions[i] == 0 && i + 1 < n) i++;
+        else if (commandes[j] == 0 && j + 1 < m) j++;
+        else {
+            if (provisions[i] == 0) i++;
+            if (commandes[j] == 0) j++;
+        }
+    }
+}
+
+long long cout_petit(const PetitProbleme *pp, const FluxPetit flux)
+{
+    long long total = 0;
+    for (int i = 0; i < pp->nb_fournisseurs; i++)
+        for (int j = 0; j < pp->nb_clients; j++)
+            total += pp->couts[i][j] * flux[i][j];
+    return total;
+}
+
+// Union-find des sommets (complétion d'une base dégénérée)
+static inline int racine(int *chef, int k)
+{
+    while (chef[k] != k) {
+        chef[k] = chef[chef[k]];
+        k = chef[k];
+    }
+    return k;
+}
+
+/*
+ * Marche-pied à taille fixe N. Sommets : lignes 0..N-1, colonnes N..2N-1.
+ * À chaque itération, un parcours en largeur depuis la ligne 0 donne les
+ * potentiels (u_i + v_j = a_ij sur la base), le père et la profondeur de
+ * chaque sommet ; le cycle de l'arc entrant (i, j) est le chemin de l'arbre
+ * entre la colonne j et la ligne i, obtenu en remontant jusqu'à l'ancêtre
+ * commun. Tarification de Dantzig (coût marginal le plus négatif, première
+ * case à égalité), comme la résolution compacte.
+ */
+#define DEFINIR_PETIT(N, Masque)                                                    \
+static int optimiser_##N(const PetitProbleme *pp, FluxPetit x)                      \
+{                                                                                   \
+    const int n = pp->nb_fournisseurs, m = pp->nb_clients;                          \
+    Masque base_l[N] = { 0 }, base_c[N] = { 0 };                                    \
+                                                                                    \
+    /* Base : cases non nulles, puis cases nulles reliant deux composantes */       \
+    int chef[2 * N];                                                                \
+    for (int k = 0; k < 2 * N; k++)                                                 \
+        chef[k] = k;                                                                \
+    int nb_arcs = 0;                                                                \
+    for (int i = 0; i < n; i++)                                                     \
+        for (int j = 0; j < m; j++) {                                               \
+            if (x[i][j] == 0)                                                       \
+                continue;                                                           \
+            int a = racine(chef, i), b = racine(chef, N + j);                       \
+            if (a == b)                                                             \
+                return -1;                                                          \
+            chef[a] = b;                                                            \
+            base_l[i] |= (Masque)(1u << j);                                         \
+            base_c[j] |= (Masque)(1u << i);                                         \
+            nb_arcs++;                                                              \
+        }                                                                           \
+    for (int i = 0; i < n && nb_arcs < n + m - 1; i++)                              \
+        for (int j = 0; j < m && nb_arcs < n + m - 1; j++) {                        \
+            int a = racine(chef, i), b = racine(chef, N + j);                       \
+            if (a == b)                                                             \
+                continue;                                                           \
+            chef[a] = b;                                                            \
+            base_l[i] |= (Masque)(1u << j);                                         \
+            base_c[j] |= (Masque)(1u << i);                                         \
+            nb_arcs++;                                                              \
+        }                                                                           \
+                                                                                    \
+    long long u[N], v[N];                                                           \
+    int pere[2 * N], prof[2 * N], file[2 * N];                                      \
+    int chemin[2 * N + 1], pile[2 * N];                                             \
+    const int iteration_max = 2 * n * m;   /* borne de sécurité */                  \
+    int iteration = 0, optimal = 0;                                                 \
+                                                                                    \
+    while (iteration < iteration_max) {                                             \
+        iteration++;                                                                \
+                                                                                    \
+        /* Potentiels */                                                            \
+        Masque vus_l = 1, vus_c = 0;                                                \
+        int tete = 0, queue = 0;                                                    \
+        file[queue++] = 0;                                                          \
+        u[0] = 0;                                                                   \
+        pere[0] = -1;                                                               \
+        prof[0] = 0;                                                                \
+        while (tete < queue) {                                                      \
+            int e = file[tete++];                                                   \
+            if (e < N) {                                                            \
+                Masque nouveaux = (Masque)(base_l[e] & ~vus_c);                     \
+                vus_c |= nouveaux;                                                  \
+                while (nouveaux) {                                                  \
+                    int j = __builtin_ctz(nouveaux);                                \
+                    nouveaux &= (Masque)(nouveaux - 1);                             \
+                    v[j] = pp->couts[e][j] - u[e];                                  \
+                    pere[N + j] = e;                                                \
+                    prof[N + j] = prof[e] + 1;                                      \
+                    file[queue++] = N + j;                                          \
+                }                                                                   \
+            } else {                                                                \
+                int j = e - N;                                                      \
+                Masque nouveaux = (Masque)(base_c[j] & ~vus_l);                     \
+                vus_l |= nouveaux;                                                  \
+                while (nouveaux) {                                                  \
+                    int i = __builtin_ctz(nouveaux);                                \
+                    nouveaux &= (Masque)(nouveaux - 1);                             \
+                    u[i] = pp->couts[i][j] - v[j];                                  \
+                    pere[i] = e;                                                    \
+                    prof[i] = prof[e] + 1;                                          \
+                    file[queue++] = i;                                              \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        /* Tarification : une case de base a un coût marginal nul, jamais */        \
+        /* retenu (inégalité stricte), d'où une boucle sans test de la base. */     \
+        /* Minimum de chaque ligne sans branchement, position cherchée ensuite */   \
+        long long meilleur = 0;                                                     \
+        int ie = -1, je = -1;                                                       \
+        for (int i = 0; i < n; i++) {                                               \
+            const long long *c = pp->couts[i];                                      \
+            long long minimum = meilleur;                                           \
+            for (int j = 0; j < m; j++) {                                           \
+                long long d = c[j] - u[i] - v[j];                                   \
+                minimum = (d < minimum) ? d : minimum;                              \
+            }                                                                       \
+            if (minimum < meilleur) {                                               \
+                je = 0;                                                             \
+                while (c[je] - u[i] - v[je] != minimum)                             \
+                    je++;                                                           \
+                meilleur = minimum;                                                 \
+                ie = i;                                                             \
+            }                                                                       \
+        }                                                                           \
+        if (ie < 0) {                                                               \
+            optimal = 1;                                                            \
+            break;                                                                  \
+        }                                                                           \
+                                                                                    \
+        /* Chemin de la colonne je à la ligne ie dans l'arbre */                    \
+        int nb = 0, nb_pile = 0;                                                    \
+        int a = N + je, b = ie;                                                     \
+        while (prof[a] > prof[b]) { chemin[nb++] = a; a = pere[a]; }                \
+        while (prof[b] > prof[a]) { pile[nb_pile++] = b; b = pere[b]; }             \
+        while (a != b) {                                                            \
+            chemin[nb++] = a; a = pere[a];                                          \
+            pile[nb_pile++] = b; b = pere[b];                                       \
+        }                                                                           \
+        chemin[nb++] = a;                                                           \
+        while (nb_pile > 0)                                                         \
+            chemin[nb++] = pile[--nb_pile];                                         \
+                                                                                    \
+        /* Arcs du chemin : signe - pour les rangs pairs, + sinon */                \
+        int theta = -1, k_sortie = 0;                                               \
+        for (int k = 0; k + 1 < nb; k += 2) {                                       \
+            int i = (chemin[k] < N) ? chemin[k] : chemin[k + 1];                    \
+            int j = ((chemin[k] < N) ? chemin[k + 1] : chemin[k]) - N;              \
+            if (theta < 0 || x[i][j] < theta) {                                     \
+                theta = x[i][j];                                                    \
+                k_sortie = k;                                                       \
+            }                                                                       \
+        }                                                                           \
+        x[ie][je] += theta;                                                         \
+        for (int k = 0; k + 1 < nb; k++) {                                          \
+            int i = (chemin[k] < N) ? chemin[k] : chemin[k + 1];                    \
+            int j = ((chemin[k] < N) ? chemin[k + 1] : chemin[k]) - N;              \
+            x[i][j] += (k % 2 == 0) ? -theta : theta;                               \
+            if (k == k_sortie) {                                                    \
+                base_l[i] &= (Masque)~(1u << j);                                    \
+                base_c[j] &= (Masque)~(1u << i);                                    \
+            }                                                                       \
+        }                                                                           \
+        base_l[ie] |= (Masque)(1u << je);                                           \
+        base_c[je] |= (Masque)(1u << ie);                                           \
+    }                                                                               \
+    /* Borne atteinte : flux est une base réalisable, sans preuve d'optimalité */   \
+    return optimal ? iteration : -2;                                                \
+}
+
+DEFINIR_PETIT(8, uint8_t)
+DEFINIR_PETIT(16, uint16_t)
+
+int optimiser_petit(const PetitProbleme *pp, FluxPetit flux)
+{
+    if (pp->nb_fournisseurs <= 8 && pp->nb_clients <= 8)
+        return optimiser_8(pp, flux);
+    return optimiser_16(pp, flux);
+}
+
+int optimiser_solution_petite(const Probleme *p, Solution *s)
+{
+    PetitProbleme pp;
+    if (!charger_petit(p, &pp))
+        return -1;
+
+    FluxPetit flux = { { 0 } };
+    for (int k = 0; k < s->nb_cases; k++)
+        flux[s->case_i[k]][s->case_j[k]] = s->flux[k];
+
+    // Base refusée ou borne de passes atteinte : s reste telle quelle et
+    // l'appelant repart du marche-pied général
+    int iterations = optimiser_petit(&pp, flux);
+    if (iterations < 0)
+        return -1;
+
+    for (int i = 0; i < pp.nb_fournisseurs; i++)
+        for (int j = 0; j < pp.nb_clients; j++)
+            if (flux[i][j] != sol_x(s, i, j))
+                sol_fixer(s, i, j, flux[i][j]);
+    return iterations;
+}
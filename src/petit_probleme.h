@@ -0,0 +1,60 @@
+#ifndef PETIT_PROBLEME_H
+#define PETIT_PROBLEME_H
+
+#include "problem.h"
+
+/*
+ * Chemin rapide des petits problèmes (n, m <= PETIT_MAX), comme les
+ * exemples de tests/ : tout tient dans des tableaux de taille fixe sur la
+ * pile, sans allocation. La base est rangée en masques de bits (colonnes
+ * de base de chaque ligne, lignes de base de chaque colonne) ; potentiels
+ * et cycle du marche-pied se calculent par parcours de l'arbre sur ces
+ * masques, en O(n + m) par itération.
+ *
+ * Le code est généré pour deux bornes, 8 (masques sur 8 bits) et 16 ; la
+ * plus petite qui contient le problème est choisie.
+ *
+ * Seuls les problèmes équilibrés à coûts denses ou implicites sont pris en
+ * charge (charger_petit renvoie 0 sinon).
+ */
+
+#define PETIT_MAX 16
+
+typedef struct {
+    int nb_fournisseurs;
+    int nb_clients;
+    long long couts[PETIT_MAX][PETIT_MAX];
+    int provisions[PETIT_MAX];
+    int commandes[PETIT_MAX];
+} PetitProbleme;
+
+typedef int FluxPetit[PETIT_MAX][PETIT_MAX];
+
+// 1 si les dimensions de p permettent le chemin rapide
+static inline int est_petit(const Probleme *p)
+{
+    return p->nb_fournisseurs > 0 && p->nb_clients > 0
+        && p->nb_fournisseurs <= PETIT_MAX && p->nb_clients <= PETIT_MAX;
+}
+
+// Copie p dans pp s'il relève du chemin rapide ; renvoie 1, sinon 0
+int charger_petit(const Probleme *p, PetitProbleme *pp);
+
+// Proposition du coin Nord-Ouest dans flux
+void nord_ouest_petit(const PetitProbleme *pp, FluxPetit flux);
+
+// Optimise la proposition flux (complétée en base si elle est dégénérée).
+// Renvoie le nombre de passes de tarification, -1 si flux n'est pas une
+// proposition de base (cases non nulles formant un cycle), ou -2 si la borne
+// de 2·n·m passes est atteinte avant l'optimalité (flux reste une solution
+// de base réalisable, mais peut-être pas optimale).
+int optimiser_petit(const PetitProbleme *pp, FluxPetit flux);
+
+long long cout_petit(const PetitProbleme *pp, const FluxPetit flux);
+
+// Optimise la solution s de p par le chemin rapide. Renvoie le nombre de
+// passes de tarification, ou -1 si p n'en relève pas ou si le chemin rapide
+// n'a pas conclu (s inchangée : l'appelant passe au marche-pied général).
+int optimiser_solution_petite(const Probleme *p, Solution *s);
+
+#endif
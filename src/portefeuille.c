@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "portefeuille.h"
+#include "annulation.h"
+#include "trace.h"
+
+typedef struct Course Course;
+
+typedef struct {
+    const Heuristique *methode;
+    const Probleme *p;
+    Solution *s;
+    Course *course;
+    int annulation;        // drapeau suivi par le thread de la méthode
+    int lance;             // 1 si le thread a été créé
+    int termine;           // protégé par course->verrou
+    int complete;          // proposition complète (non annulée, tout est servi)
+    long long cout;
+    double temps;          // secondes écoulées depuis le départ
+    pthread_t thread;
+} Concurrent;
+
+struct Course {
+    pthread_mutex_t verrou;
+    pthread_cond_t arrivee;
+    int nb_termines;
+    int nb_completes;
+    double reference;      // arrivée de la PORTEFEUILLE_QUORUM-ième proposition complète (-1 : pas encore)
+    double debut;
+};
+
+static double temps_reel(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// La proposition sert-elle tout ce qui peut l'être (min des deux totaux) ?
+static int proposition_complete(const Probleme *p, const Solution *s)
+{
+    long long offre = 0, demande = 0, servi = 0;
+    for (int i = 0; i < p->nb_fournisseurs; i++)
+        offre += p->provisions[i];
+    for (int j = 0; j < p->nb_clients; j++)
+        demande += p->commandes[j];
+    for (int k = 0; k < s->nb_cases; k++)
+        servi += s->flux[k];
+    return servi == ((offre < demande) ? offre : demande);
+}
+
+// Calcule la proposition du concurrent c, traces muettes
+static void calculer(Concurrent *c)
+{
+    SortieTrace precedente = trace_sortie();
+    trace_rediriger((SortieTrace){ 0, NULL });
+    suivre_annulation(&c->annulation);
+
+    c->methode->calculer(c->p, c->s, 1);
+
+    suivre_annulation(NULL);
+    trace_rediriger(precedente);
+
+    c->complete = proposition_complete(c->p, c->s);
+    c->cout = c->complete ? cout_total(c->p, c->s) : -1;
+}
+
+static void *courir(void *arg)
+{
+    Concurrent *c = arg;
+    Course *course = c->course;
+
+    calculer(c);
+
+    pthread_mutex_lock(&course->verrou);
+    c->temps = temps_reel() - course->debut;
+    c->termine = 1;
+    if (c->complete && ++course->nb_completes == PORTEFEUILLE_QUORUM)
+        course->reference = c->temps;
+    course->nb_termines++;
+    pthread_cond_signal(&course->arrivee);
+    pthread_mutex_unlock(&course->verrou);
+    return NULL;
+}
+
+// Attend tous les concurrents lancés, en annulant les retardataires ;
+// renvoie 1 s'il a fallu en annuler. Une
+// seule échéance absolue depuis le départ : delai_max dès le lancement,
+// ramenée à PORTEFEUILLE_FACTEUR x reference quand le quorum est atteint.
+static int arbitrer(Course *course, Concurrent *c, int nb, int nb_lances, double delai_max)
+{
+    int annulee = 0;
+
+    pthread_mutex_lock(&course->verrou);
+    while (course->nb_termines < nb_lances) {
+        double limite = delai_max;   // <= 0 : pas encore d'échéance
+        if (course->reference >= 0) {
+            double relative = PORTEFEUILLE_FACTEUR * course->reference;
+            if (limite <= 0 || relative < limite)
+                limite = relative;
+        }
+
+        if (annulee || limite <= 0) {
+            pthread_cond_wait(&course->arrivee, &course->verrou);
+            continue;
+        }
+
+        if (temps_reel() - course->debut >= limite) {
+            for (int k = 0; k < nb; k++)
+                if (c[k].lance && !c[k].termine)
+                    lever_annulation(&c[k].annulation);
+            annulee = 1;
+            continue;
+        }
+
+        double echeance = course->debut + limite;
+        struct timespec ts;
+        ts.tv_sec = (time_t)echeance;
+        ts.tv_nsec = (long)((echeance - (double)ts.tv_sec) * 1e9);
+        pthread_cond_timedwait(&course->arrivee, &course->verrou, &ts);
+    }
+    pthread_mutex_unlock(&course->verrou);
+    return annulee;
+}
+
+const Heuristique *portefeuille(const Probleme *p, Solution *s, double delai_max,
+                               int *hors_delai)
+{
+    if (hors_delai)
+        *hors_delai = 0;
+    int nb = nb_heuristiques();
+    Concurrent *c = calloc((size_t)nb, sizeof(Concurrent));
+    if (!c)
+        return NULL;
+
+    Course course = { .nb_termines = 0, .nb_completes = 0, .reference = -1.0 };
+    pthread_condattr_t attributs;
+    pthread_condattr_init(&attributs);
+    pthread_condattr_setclock(&attributs, CLOCK_MONOTONIC);
+    pthread_mutex_init(&course.verrou, NULL);
+    pthread_cond_init(&course.arrivee, &attributs);
+    pthread_condattr_destroy(&attributs);
+
+    int en_parallele = !p->tuilage;
+    trace("Portefeuille : %d méthodes %s\n", nb,
+          en_parallele ? "en parallèle" : "l'une après l'autre (lecture par tuiles)");
+
+    course.debut = temps_reel();
+    int nb_lances = 0;
+    for (int k = 0; k < nb; k++) {
+        c[k].methode = heuristique(k);
+        c[k].p = p;
+        c[k].course = &course;
+        c[k].s = creer_solution_vide(p);
+        if (!c[k].s)
+            continue;
+        if (en_parallele) {
+            c[k].lance = (pthread_create(&c[k].thread, NULL, courir, &c[k]) == 0);
+            nb_lances += c[k].lance;
+        } else {
+            calculer(&c[k]);
+            c[k].temps = temps_reel() - course.debut;
+            c[k].termine = 1;
+        }
+    }
+
+    int annulee = 0;
+    if (en_parallele) {
+        annulee = arbitrer(&course, c, nb, nb_lances, delai_max);
+        for (int k = 0; k < nb; k++)
+            if (c[k].lance)
+                pthread_join(c[k].thread, NULL);
+    }
+
+    int retenu = -1;
+    for (int k = 0; k < nb; k++) {
+        if (c[k].complete) {
+            trace("  %-4s coût %lld en %.6f s\n", c[k].methode->nom, c[k].cout, c[k].temps);
+            if (retenu < 0 || c[k].cout < c[retenu].cout)
+                retenu = k;
+        } else if (c[k].termine) {
+            trace("  %-4s %s après %.6f s\n", c[k].methode->nom,
+                  c[k].annulation ? "annulée" : "incomplète", c[k].temps);
+        } else {
+            trace("  %-4s non lancée (mémoire insuffisante)\n", c[k].methode->nom);
+        }
+    }
+
+    const Heuristique *methode = NULL;
+    if (retenu >= 0) {
+        const Solution *gagnante = c[retenu].s;
+        for (int k = 0; k < gagnante->nb_cases; k++)
+            sol_fixer(s, gagnante->case_i[k], gagnante->case_j[k], gagnante->flux[k]);
+        methode = c[retenu].methode;
+        trace("Proposition retenue : %s (coût %lld)\n", methode->titre, c[retenu].cout);
+    } else if (annulee) {
+        trace("Portefeuille : aucune proposition complète avant l'échéance\n");
+        if (hors_delai)
+            *hors_delai = 1;
+    }
+
+    for (int k = 0; k < nb; k++)
+        if (c[k].s)
+            liberer_solution(c[k].s);
+    pthread_mutex_destroy(&course.verrou);
+    pthread_cond_destroy(&course.arrivee);
+    free(c);
+    return methode;
+}
@@ -0,0 +1,32 @@
+#ifndef PORTEFEUILLE_H
+#define PORTEFEUILLE_H
+
+#include "problem.h"
+#include "heuristiques.h"
+
+/*
+ * Mode portefeuille : toutes les méthodes du registre (heuristiques.h)
+ * calculent leur proposition en même temps, chacune dans son thread et sur
+ * sa propre copie de la solution. Si delai_max > 0, toutes les méthodes
+ * encore en cours delai_max secondes après le départ sont annulées
+ * (annulation.h), quorum atteint ou non. Quand PORTEFEUILLE_QUORUM
+ * propositions complètes sont arrivées, la dernière en t secondes,
+ * l'échéance est avancée à PORTEFEUILLE_FACTEUR x t depuis le départ. Une méthode rapide mais grossière (Nord-Ouest) ne fixe
+ * donc pas seule l'échéance. Seule la proposition complète la moins chère
+ * est recopiée dans s (à coût égal, la première du registre).
+ *
+ * Sur un problème lu par tuiles, les méthodes s'exécutent l'une après
+ * l'autre dans le thread appelant, sans annulation : le parcours par tuiles
+ * n'est pas partagé entre threads.
+ */
+
+#define PORTEFEUILLE_QUORUM 2
+#define PORTEFEUILLE_FACTEUR 4.0
+
+// Renvoie la méthode retenue (la moins chère des propositions complètes
+// arrivées avant l'échéance), ou NULL si aucune n'est complète : *hors_delai
+// vaut alors 1 si des méthodes ont été annulées, 0 si la mémoire a manqué
+const Heuristique *portefeuille(const Probleme *p, Solution *s, double delai_max,
+                               int *hors_delai);
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <limits.h>
 #include "potentiel.h"
+#include "tuiles.h"
 #include "trace.h"
 
 /*
@@ -12,37 +14,16 @@
  *
  * La fonction renvoie l'indice du sommet choisi.
  */
-static int choisir_sommet_depart(const Base *b, int n, int m)
+static int choisir_sommet_depart(const AdjacenceBase *adj)
 {
-    int total = n + m;
-    int degres[64];   /* on part du principe que ca sera suffisant  */
-    int i;
-
-    /* Initialisation des degrés à 0 */
-    // Degres c est le nombre de connexion quil a 
-    for (i = 0; i < total; i++)
-        degres[i] = 0;
-
-    /* Comptage des degrés à partir de la base */
-    if (b) {
-        for (i = 0; i < b->nb_arcs; i++) {
-            int fi = b->arcs[i][0];      /* fournisseur */
-            int cj = b->arcs[i][1];      /* client */
-            int u = fi;
-            int v = n + cj;
-
-            if (u >= 0 && u < total) degres[u]++;
-            if (v >= 0 && v < total) degres[v]++;
-        }
-    }
-
-    /* Choix du sommet de degré max */
+    /* Degres c est le nombre de connexion quil a : lu directement dans l'adjacence */
     int sommet = 0;
     int deg_max = -1;
-    for (i = 0; i < total; i++) {
-        if (degres[i] > deg_max) {
-            deg_max = degres[i];
-            sommet = i;
+    for (int u = 0; u < adj->nb_sommets; u++) {
+        int degre = adj->debut[u + 1] - adj->debut[u];
+        if (degre > deg_max) {
+            deg_max = degre;
+            sommet = u;
         }
     }
 
@@ -50,94 +31,168 @@ static int choisir_sommet_depart(const Base *b, int n, int m)
 }
 
 /*
- * Calcule les potentiels E(F_i) -> fournisseur et E(C_j) -> commandes à partir de la base.
- * On suppose que la base correspond à une proposition non dégénérée 
- * (graphe connexe et acyclique).
+ * Parcours en largeur depuis la racine sur l'adjacence : chaque arc est vu
+ * deux fois, O(n + m). Les sommets non atteints (base non connexe) gardent
+ * un potentiel nul.
  */
-void calculer_potentiels(const Probleme *p, const Base *b,
-                         int *pot_f, int *pot_c)
+static void propager_potentiels(const Probleme *p, const AdjacenceBase *adj, int racine,
+                                long long *pot_f, long long *pot_c,
+                                int *file, char *visite)
 {
-    if (!p || !b || !pot_f || !pot_c)
-        return;
+    int n = adj->nb_fournisseurs;
+    int total = adj->nb_sommets;
 
-    int n = p->nb_fournisseurs;
-    int m = p->nb_clients;
-    int total = n + m;
+    for (int u = 0; u < total; u++)
+        visite[u] = 0;
+    for (int i = 0; i < n; i++)
+        pot_f[i] = 0;
+    for (int j = 0; j < total - n; j++)
+        pot_c[j] = 0;
 
-    /* On travaille d'abord sur un tableau de potentiels "par sommet" */
-    int pot_sommet[64];
-    int visite[64];
-    int file[64];
     int tete = 0, queue = 0;
-
-    if (total > 64) {
-        
-        // secu si ca depasse 64
-        trace("Erreur : nombre total de sommets trop grand pour calculer les potentiels.\n");
-        return;
-    }
-
-    int i;
-    for (i = 0; i < total; i++) {
-        pot_sommet[i] = 0;
-        visite[i] = 0;
-    }
-
-    /* Choix du sommet de départ : celui qui a le plus de liaisons */
-    int racine = choisir_sommet_depart(b, n, m);
     visite[racine] = 1;
-    pot_sommet[racine] = 0;  /* on va fixer sa valeur à 0 */
-
     file[queue++] = racine;
 
-    /* Parcours en largeur sur le graphe biparti défini par la base */
     while (tete < queue) {
         int u = file[tete++];
-        int est_fournisseur = (u < n);
-
-        for (i = 0; i < b->nb_arcs; i++) {
-            int fi = b->arcs[i][0];
-            int cj = b->arcs[i][1];
-            int noeud_f = fi;
-            int noeud_c = n + cj;
-
-            int v;
-            int cout = p->couts[fi][cj];
-
-            if (est_fournisseur && u == noeud_f) {
-                /* u  = fournisseur, v = client */
-                v = noeud_c;
-                if (!visite[v]) {
-                    /* cout = E(F_i) - E(C_j) */
-                    pot_sommet[v] = pot_sommet[u] - cout;
-                    visite[v] = 1;
-                    file[queue++] = v;
-                }
-            } else if (!est_fournisseur && u == noeud_c) {
-                v = noeud_f;
-                if (!visite[v]) {
-                    /* cout = E(F_i) - E(C_j)  =>  E(F_i) = cout + E(C_j) : c'est la qu'est defini mon nouveau coup */
-                    pot_sommet[v] = cout + pot_sommet[u];
-                    visite[v] = 1;
-                    file[queue++] = v;
-                }
+
+        for (int k = adj->debut[u]; k < adj->debut[u + 1]; k++) {
+            int v = adj->voisins[k];
+            if (visite[v])
+                continue;
+            visite[v] = 1;
+            file[queue++] = v;
+
+            if (u < n) {
+                /* u = fournisseur, v = client : cout = E(F_i) - E(C_j) */
+                pot_c[v - n] = pot_f[u] - cout_arc(p, u, v - n);
+            } else {
+                /* E(F_i) = cout + E(C_j) : c'est la qu'est defini mon nouveau coup */
+                pot_f[v] = cout_arc(p, v, u - n) + pot_c[u - n];
             }
         }
     }
+}
+
+/*
+ * Calcule les potentiels E(F_i) -> fournisseur et E(C_j) -> commandes à partir de la base.
+ * On suppose que la base correspond à une proposition non dégénérée 
+ * (graphe connexe et acyclique).
+ */
+int calculer_potentiels(const Probleme *p, const AdjacenceBase *adj,
+                        long long *pot_f, long long *pot_c, Arene *a)
+{
+    if (!p || !adj || !pot_f || !pot_c)
+        return -1;
+
+    int total = adj->nb_sommets;
+    if (total <= 0)
+        return 0;
+
+    /* File et marques de visite : dans l'arène, ou malloc sans arène */
+    MarqueArene marque = { NULL, 0 };
+    int *file;
+    char *visite;
+    if (a) {
+        marque = arene_marque(a);
+        file = arene_alloc(a, (size_t)total * sizeof(int));
+        visite = arene_alloc(a, (size_t)total);
+    } else {
+        file = malloc((size_t)total * sizeof(int));
+        visite = malloc((size_t)total);
+    }
+    if (!file || !visite) {
+        if (a) {
+            arene_revenir(a, marque);
+        } else {
+            free(file);
+            free(visite);
+        }
+        return -1;
+    }
+
+    /* Choix du sommet de départ : celui qui a le plus de liaisons, potentiel 0 */
+    propager_potentiels(p, adj, choisir_sommet_depart(adj), pot_f, pot_c, file, visite);
+
+    if (a) {
+        arene_revenir(a, marque);
+    } else {
+        free(file);
+        free(visite);
+    }
+    return 0;
+}
+
+void normaliser_potentiels(const AdjacenceBase *adj, long long *pot_f, long long *pot_c)
+{
+    int n = adj->nb_fournisseurs;
+    int racine = choisir_sommet_depart(adj);
+    long long decalage = (racine < n) ? pot_f[racine] : pot_c[racine - n];
+
+    for (int i = 0; i < n; i++)
+        pot_f[i] -= decalage;
+    for (int j = 0; j < adj->nb_sommets - n; j++)
+        pot_c[j] -= decalage;
+}
 
-    /* Recopie dans les tableaux de sortie */
-    for (i = 0; i < n; i++)
-        pot_f[i] = pot_sommet[i];
+/*
+ * Potentiels sur la base enracinée (arbre_base.h) ----------------------------
+ */
+
+int enraciner_potentiels(ArbreBase *t, const Probleme *p, const AdjacenceBase *adj,
+                         long long *pot_f, long long *pot_c)
+{
+    int n = adj->nb_fournisseurs;
+    int nb = enraciner_arbre(t, adj, choisir_sommet_depart(adj));
+
+    for (int i = 0; i < n; i++)
+        pot_f[i] = 0;
+    for (int j = 0; j < adj->nb_sommets - n; j++)
+        pot_c[j] = 0;
+
+    /* Ordre préfixe : le père de chaque sommet est déjà traité */
+    for (int q = 1; q < nb; q++) {
+        int v = t->travail[q];
+        int u = t->pere[v];
+        if (u < n)
+            pot_c[v - n] = pot_f[u] - cout_arc(p, u, v - n);
+        else
+            pot_f[v] = cout_arc(p, v, u - n) + pot_c[u - n];
+    }
+    return t->racine >= 0;
+}
 
-    for (i = 0; i < m; i++)
-        pot_c[i] = pot_sommet[n + i];
+/*
+ * Seul le sous-arbre raccroché par pivoter_arbre change de potentiels, tous
+ * du même décalage, pour que l'arc entrant ait un coût marginal nul :
+ * + marginal s'il contient F_ie (E(F_ie) augmente), - marginal s'il contient
+ * C_je. Après le pivot, F_ie est dans le sous-arbre si son père est C_je.
+ */
+int mettre_a_jour_potentiels(ArbreBase *t, int i_entree, int j_entree,
+                             int i_sortie, int j_sortie,
+                             long long marginal, long long *pot_f, long long *pot_c)
+{
+    int n = t->nb_fournisseurs;
+    int nb = pivoter_arbre(t, i_entree, j_entree, i_sortie, j_sortie);
+    if (nb < 0)
+        return -1;
+
+    long long decalage = (t->pere[i_entree] == n + j_entree) ? marginal : -marginal;
+    for (int r = 0; r < nb; r++) {
+        int u = t->travail[r];
+        if (u < n)
+            pot_f[u] += decalage;
+        else
+            pot_c[u - n] += decalage;
+    }
+    return nb;
 }
 
 
  //Affiche les potentiels pour chaque sommet.
 
 void afficher_potentiels(const Probleme *p,
-                         const int *pot_f, const int *pot_c)
+                         const long long *pot_f, const long long *pot_c)
 {
     if (!p || !pot_f || !pot_c)
         return;
@@ -150,12 +205,12 @@ void afficher_potentiels(const Probleme *p,
 
     trace("Fournisseurs :\n");
     for (i = 0; i < n; i++) {
-        trace("  E(F%d) = %d\n", i, pot_f[i]);
+        trace("  E(F%d) = %lld\n", i, pot_f[i]);
     }
 
     trace("Clients :\n");
     for (i = 0; i < m; i++) {
-        trace("  E(C%d) = %d\n", i, pot_c[i]);
+        trace("  E(C%d) = %lld\n", i, pot_c[i]);
     }
 
     trace("==================\n\n");
@@ -165,7 +220,7 @@ void afficher_potentiels(const Probleme *p,
  * Affiche la table des coûts potentiels cp_ij = E(F_i) - E(C_j).
  */
 void afficher_table_couts_potentiels(const Probleme *p,
-                                     const int *pot_f, const int *pot_c)
+                                     const long long *pot_f, const long long *pot_c)
 {
     if (!p || !pot_f || !pot_c)
         return;
@@ -188,8 +243,8 @@ void afficher_table_couts_potentiels(const Probleme *p,
     for (i = 0; i < n; i++) {
         trace("F%-3d ", i);
         for (j = 0; j < m; j++) {
-            int cp = pot_f[i] - pot_c[j];
-            trace("%7d", cp);
+            long long cp = pot_f[i] - pot_c[j];
+            trace("%7lld", cp);
         }
         trace("\n");
     }
@@ -201,23 +256,11 @@ void afficher_table_couts_potentiels(const Probleme *p,
  * Calcule et affiche la table des coûts marginaux)
  * et dis si éventuellement une arête améliorante possible.
  */
-static int arc_dans_base(const Base *b, int i, int j)
-{
-    if (!b)
-        return 0;
-
-    for (int k = 0; k < b->nb_arcs; k++) {
-        if (b->arcs[k][0] == i && b->arcs[k][1] == j)
-            return 1;
-    }
-    return 0;
-}
-
 int calculer_et_afficher_couts_marginaux(const Probleme *p,
                                          const Solution *s,
                                          const Base *b,
-                                         const int *pot_f,
-                                         const int *pot_c,
+                                         const long long *pot_f,
+                                         const long long *pot_c,
                                          int *i_entree,
                                          int *j_entree)
 {
@@ -231,7 +274,7 @@ int calculer_et_afficher_couts_marginaux(const Probleme *p,
 
     int meilleur_i = -1;
     int meilleur_j = -1;
-    int meilleur_marginal = 0;   /* on cherche un coût marginal STRICTEMENT négatif */
+    long long meilleur_marginal = 0;   /* on cherche un coût marginal STRICTEMENT négatif */
 
     trace("=== TABLE DES COUTS MARGINAUX ===\n\n");
 
@@ -244,11 +287,22 @@ int calculer_et_afficher_couts_marginaux(const Probleme *p,
 
     for (i = 0; i < n; i++) {
         trace("F%-3d ", i);
+        entrer_tuile(p, i);
+        int k = est_creux(p) ? p->debut_ligne[i] : 0;   // curseur dans la ligne creuse
         for (j = 0; j < m; j++) {
-            int cp = pot_f[i] - pot_c[j];
-            int marginal = p->couts[i][j] - cp;
+            /* Variante creuse : seuls les arcs autorisés peuvent entrer dans la base */
+            if (est_creux(p)) {
+                if (k >= p->debut_ligne[i + 1] || p->arc_client[k] != j) {
+                    trace("%7s", ".");
+                    continue;
+                }
+                k++;
+            }
+
+            long long cp = pot_f[i] - pot_c[j];
+            long long marginal = cout_arc(p, i, j) - cp;
 
-            trace("%7d", marginal);
+            trace("%7lld", marginal);
 
             /* On ne considère que les cases hors base (pas présentes dans b) pour l'arête améliorante */
             if (!arc_dans_base(b, i, j) && marginal < meilleur_marginal) {
@@ -268,7 +322,7 @@ int calculer_et_afficher_couts_marginaux(const Probleme *p,
         return 1;  /* optimale */
     }
 
-    trace("Arête améliorante retenue : (F%d, C%d) avec coût marginal %d.\n\n",
+    trace("Arête améliorante retenue : (F%d, C%d) avec coût marginal %lld.\n\n",
            meilleur_i, meilleur_j, meilleur_marginal);
 
     if (i_entree)
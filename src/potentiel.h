@@ -3,16 +3,47 @@
 
 #include "problem.h"
 #include "base.h"
+#include "arene.h"
+#include "arbre_base.h"
 
 /*
  * calculer_potentiels
- * - Entrées : problème p, base b
+ * - Entrées : problème p, adjacence de la base
  * - Sorties : pot_f[i] = E(F_i), pot_c[j] = E(C_j)
  * - Idée : pour chaque arc basique (i,j), on impose
- *          cout_ij = E(F_i) - E(C_j) et on propage.
+ *          cout_ij = E(F_i) - E(C_j) et on propage (en O(n + m)).
+ * - Tableaux de travail pris dans l'arène a (NULL : malloc).
+ *   Renvoie 0, ou -1 si la mémoire manque.
  */
-void calculer_potentiels(const Probleme *p, const Base *b,
-                         int *pot_f, int *pot_c);
+int calculer_potentiels(const Probleme *p, const AdjacenceBase *adj,
+                        long long *pot_f, long long *pot_c, Arene *a);
+
+/*
+ * normaliser_potentiels
+ * - Décale tous les potentiels pour que le sommet de départ de
+ *   calculer_potentiels (le plus connecté) vaille 0 : mêmes valeurs
+ *   qu'un recalcul complet, pour les affichages.
+ */
+void normaliser_potentiels(const AdjacenceBase *adj, long long *pot_f, long long *pot_c);
+
+// Enracine la base (enraciner_arbre, même racine que calculer_potentiels)
+// et calcule les potentiels complets dans l'ordre préfixe. Renvoie 1 si la
+// base est un arbre couvrant ; sinon l'arbre reste invalide (les potentiels
+// sont calculés quand même, à recalculer au pivot suivant).
+int enraciner_potentiels(ArbreBase *t, const Probleme *p, const AdjacenceBase *adj,
+                         long long *pot_f, long long *pot_c);
+
+/*
+ * mettre_a_jour_potentiels
+ * - Pivot où (i_entree, j_entree), de coût marginal `marginal`, remplace
+ *   (i_sortie, j_sortie) : raccroche l'arbre (pivoter_arbre) et décale les
+ *   potentiels du seul sous-arbre coupé.
+ * - Renvoie le nombre de sommets mis à jour, ou -1 si l'arbre est à
+ *   recalculer (il est alors invalidé).
+ */
+int mettre_a_jour_potentiels(ArbreBase *t, int i_entree, int j_entree,
+                             int i_sortie, int j_sortie,
+                             long long marginal, long long *pot_f, long long *pot_c);
 
 /*
  * afficher_potentiels
@@ -20,7 +51,7 @@ void calculer_potentiels(const Probleme *p, const Base *b,
  *   et E(C_j) pour tous les clients.
  */
 void afficher_potentiels(const Probleme *p,
-                         const int *pot_f, const int *pot_c);
+                         const long long *pot_f, const long long *pot_c);
 
 /*
  * afficher_table_couts_potentiels
@@ -28,24 +59,24 @@ void afficher_potentiels(const Probleme *p,
  *   (même format que la matrice de coûts).
  */
 void afficher_table_couts_potentiels(const Probleme *p,
-                                     const int *pot_f, const int *pot_c);
+                                     const long long *pot_f, const long long *pot_c);
 
 /*
- * calculer_et_afficher_couts_marginaux
- * - Calcule m_ij = cout_ij - (E(F_i) - E(C_j))
- * - Affiche la table des coûts marginaux
- * - Ne regarde que les cases hors base (vraiment hors base, pas seulement x_ij == 0) :
- *      * si toutes ont m_ij >= 0 → solution optimale, renvoie 1
- *      * sinon → choisit la case avec m_ij le plus négatif,
- *                met ses indices dans (i_entree, j_entree),
- *                renvoie 0.
- */
-int calculer_et_afficher_couts_marginaux(const Probleme *p,
-                                         const Solution *s,
-                                         const Base *b,
-                                         const int *pot_f,
-                                         const int *pot_c,
-                                         int *i_entree,
-                                         int *j_entree);
-
-#endif
+ * calculer_et_afficher_couts_marginaux
+ * - Calcule m_ij = cout_ij - (E(F_i) - E(C_j))
+ * - Affiche la table des coûts marginaux
+ * - Ne regarde que les cases hors base (vraiment hors base, pas seulement x_ij == 0) :
+ *      * si toutes ont m_ij >= 0 → solution optimale, renvoie 1
+ *      * sinon → choisit la case avec m_ij le plus négatif,
+ *                met ses indices dans (i_entree, j_entree),
+ *                renvoie 0.
+ */
+int calculer_et_afficher_couts_marginaux(const Probleme *p,
+                                         const Solution *s,
+                                         const Base *b,
+                                         const long long *pot_f,
+                                         const long long *pot_c,
+                                         int *i_entree,
+                                         int *j_entree);
+
+#endif
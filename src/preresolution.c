@@ -0,0 +1,384 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include "preresolution.h"
+#include "couts.h"
+
+/*
+ * Regroupement des lignes ou colonnes identiques ------------------------------
+ */
+
+#define EMPREINTE_BASE 14695981039346656037ULL
+#define EMPREINTE_PREMIER 1099511628211ULL
+
+static unsigned long long melanger(unsigned long long h, long long c)
+{
+    h = (h ^ (unsigned long long)c) * EMPREINTE_PREMIER;
+    return h ^ (h >> 29);
+}
+
+typedef struct {
+    unsigned long long empreinte;
+    int k;
+} Cle;
+
+static int comparer_cles(const void *a, const void *b)
+{
+    const Cle *x = a, *y = b;
+    if (x->empreinte != y->empreinte)
+        return (x->empreinte < y->empreinte) ? -1 : 1;
+    return (x->k > y->k) - (x->k < y->k);
+}
+
+// Comparaison exacte de deux lignes (ou colonnes) sur les indices autres[]
+typedef struct {
+    const Probleme *p;
+    const int *autres;
+    int nb_autres;
+    int par_ligne;
+} Comparaison;
+
+static int identiques(const Comparaison *c, int a, int b)
+{
+    for (int t = 0; t < c->nb_autres; t++) {
+        int o = c->autres[t];
+        long long x = c->par_ligne ? cout_dense(c->p, a, o) : cout_dense(c->p, o, a);
+        long long y = c->par_ligne ? cout_dense(c->p, b, o) : cout_dense(c->p, o, b);
+        if (x != y)
+            return 0;
+    }
+    return 1;
+}
+
+/* Numérote les groupes d'éléments identiques parmi elements[0..nb-1] (rangés
+   par indice croissant) : groupe[e] reçoit le numéro de son groupe, les
+   groupes étant numérotés dans l'ordre de leur premier membre. Les
+   empreintes ne font que trier ; l'égalité est toujours vérifiée.
+   Renvoie le nombre de groupes, ou -1 si la mémoire manque. */
+static int regrouper(const int *elements, int nb, const unsigned long long *empreinte,
+                     const Comparaison *cmp, int *groupe, Arene *a)
+{
+    MarqueArene marque = arene_marque(a);
+    Cle *cles = arene_alloc(a, (size_t)nb * sizeof(Cle));
+    int *chefs = arene_alloc(a, (size_t)nb * sizeof(int));
+    if (!cles || !chefs)
+        return -1;
+
+    for (int t = 0; t < nb; t++)
+        cles[t] = (Cle){ empreinte[elements[t]], elements[t] };
+    qsort(cles, (size_t)nb, sizeof(Cle), comparer_cles);
+
+    // Dans une série de même empreinte, chaque élément rejoint le premier
+    // élément identique (son chef), qui le précède
+    for (int debut = 0; debut < nb;) {
+        int fin = debut;
+        while (fin < nb && cles[fin].empreinte == cles[debut].empreinte)
+            fin++;
+        int nb_chefs = 0;
+        for (int t = debut; t < fin; t++) {
+            int e = cles[t].k, c = 0;
+            while (c < nb_chefs && !identiques(cmp, chefs[c], e))
+                c++;
+            if (c == nb_chefs)
+                chefs[nb_chefs++] = e;
+            groupe[e] = chefs[c];
+        }
+        debut = fin;
+    }
+
+    int nb_groupes = 0;
+    for (int t = 0; t < nb; t++) {
+        int e = elements[t];
+        groupe[e] = (groupe[e] == e) ? nb_groupes++ : groupe[groupe[e]];
+    }
+
+    arene_revenir(a, marque);
+    return nb_groupes;
+}
+
+// Membres de chaque groupe, par indice croissant (debut : nb_groupes + 1)
+static int lister_membres(const int *elements, int nb, const int *groupe, int nb_groupes,
+                          int **debut, int **membres, Arene *a)
+{
+    *debut = arene_calloc(a, (size_t)nb_groupes + 1, sizeof(int));
+    *membres = arene_alloc(a, (size_t)nb * sizeof(int));
+    if (!*debut || !*membres)
+        return -1;
+
+    for (int t = 0; t < nb; t++)
+        (*debut)[groupe[elements[t]] + 1]++;
+    for (int g = 0; g < nb_groupes; g++)
+        (*debut)[g + 1] += (*debut)[g];
+
+    MarqueArene marque = arene_marque(a);
+    int *place = arene_alloc(a, (size_t)nb_groupes * sizeof(int));
+    if (!place)
+        return -1;
+    for (int g = 0; g < nb_groupes; g++)
+        place[g] = (*debut)[g];
+    for (int t = 0; t < nb; t++)
+        (*membres)[place[groupe[elements[t]]]++] = elements[t];
+    arene_revenir(a, marque);
+    return 0;
+}
+
+/*
+ * Préresolution ------------------------------------------------------------------
+ */
+
+Preresolution *preresoudre(const Probleme *p, Arene *a)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    if (!p->couts || p->tuilage || p->largeur_couts > 4)
+        return NULL;
+
+    MarqueArene marque = arene_marque(a);
+    Preresolution *pr = arene_calloc(a, 1, sizeof(Preresolution));
+    int *lignes = arene_alloc(a, (size_t)n * sizeof(int));
+    int *colonnes = arene_alloc(a, (size_t)m * sizeof(int));
+    unsigned long long *empreinte_l = arene_alloc(a, (size_t)n * sizeof(unsigned long long));
+    unsigned long long *empreinte_c = arene_alloc(a, (size_t)m * sizeof(unsigned long long));
+    if (!pr || !lignes || !colonnes || !empreinte_l || !empreinte_c)
+        goto echec;
+    pr->origine = p;
+    pr->groupe_ligne = arene_alloc(a, (size_t)n * sizeof(int));
+    pr->groupe_colonne = arene_alloc(a, (size_t)m * sizeof(int));
+    if (!pr->groupe_ligne || !pr->groupe_colonne)
+        goto echec;
+
+    // Retrait des quantités nulles
+    long long offre = 0, demande = 0;
+    int nl = 0, nc = 0;
+    for (int i = 0; i < n; i++) {
+        offre += p->provisions[i];
+        pr->groupe_ligne[i] = -1;
+        if (p->provisions[i] > 0)
+            lignes[nl++] = i;
+    }
+    for (int j = 0; j < m; j++) {
+        demande += p->commandes[j];
+        pr->groupe_colonne[j] = -1;
+        if (p->commandes[j] > 0)
+            colonnes[nc++] = j;
+    }
+    if (nl == 0 || nc == 0)
+        goto echec;
+
+    // Lignes identiques sur les colonnes gardées
+    for (int t = 0; t < nl; t++) {
+        unsigned long long h = EMPREINTE_BASE;
+        for (int u = 0; u < nc; u++)
+            h = melanger(h, cout_dense(p, lignes[t], colonnes[u]));
+        empreinte_l[lignes[t]] = h;
+    }
+    Comparaison cl = { p, colonnes, nc, 1 };
+    int n2 = regrouper(lignes, nl, empreinte_l, &cl, pr->groupe_ligne, a);
+    if (n2 < 0 || lister_membres(lignes, nl, pr->groupe_ligne, n2,
+                                 &pr->debut_ligne, &pr->membres_ligne, a) != 0)
+        goto echec;
+
+    int *rep_l = arene_alloc(a, (size_t)n2 * sizeof(int));
+    if (!rep_l)
+        goto echec;
+    for (int g = 0; g < n2; g++)
+        rep_l[g] = pr->membres_ligne[pr->debut_ligne[g]];
+
+    // Colonnes identiques sur les lignes réduites (empreintes ligne par ligne)
+    for (int u = 0; u < nc; u++)
+        empreinte_c[colonnes[u]] = EMPREINTE_BASE;
+    for (int g = 0; g < n2; g++)
+        for (int u = 0; u < nc; u++)
+            empreinte_c[colonnes[u]] = melanger(empreinte_c[colonnes[u]],
+                                                cout_dense(p, rep_l[g], colonnes[u]));
+    Comparaison cc = { p, rep_l, n2, 0 };
+    int m2 = regrouper(colonnes, nc, empreinte_c, &cc, pr->groupe_colonne, a);
+    if (m2 < 0 || lister_membres(colonnes, nc, pr->groupe_colonne, m2,
+                                 &pr->debut_colonne, &pr->membres_colonne, a) != 0)
+        goto echec;
+
+    int equilibre = (offre == demande);
+    if ((n2 == n && m2 == m && !equilibre)
+        || (size_t)n2 * m2 * sizeof(int32_t) > PRERESOLUTION_OCTETS_MAX)
+        goto echec;
+
+    Probleme *q = creer_probleme_dans(a, n2, m2);
+    long long *v = arene_alloc(a, (size_t)m2 * sizeof(long long));
+    if (!q || !v)
+        goto echec;
+
+    for (int g = 0; g < n2; g++) {
+        long long somme = 0;
+        for (int k = pr->debut_ligne[g]; k < pr->debut_ligne[g + 1]; k++)
+            somme += p->provisions[pr->membres_ligne[k]];
+        if (somme > INT_MAX)
+            goto echec;
+        q->provisions[g] = (int)somme;
+    }
+    for (int g = 0; g < m2; g++) {
+        long long somme = 0;
+        for (int k = pr->debut_colonne[g]; k < pr->debut_colonne[g + 1]; k++)
+            somme += p->commandes[pr->membres_colonne[k]];
+        if (somme > INT_MAX)
+            goto echec;
+        q->commandes[g] = (int)somme;
+        v[g] = LLONG_MAX;
+    }
+
+    // Coûts des représentants, moins le minimum de leur ligne (u), puis de
+    // leur colonne (v) ; seulement sur un problème équilibré, où chaque
+    // ligne et chaque colonne est entièrement servie
+    int change = (n2 != n || m2 != m);
+    for (int g = 0; g < n2; g++) {
+        long long u = 0;
+        if (equilibre) {
+            u = LLONG_MAX;
+            for (int h = 0; h < m2; h++) {
+                long long c = cout_dense(p, rep_l[g], pr->membres_colonne[pr->debut_colonne[h]]);
+                if (c < u)
+                    u = c;
+            }
+        }
+        for (int h = 0; h < m2; h++) {
+            long long c = cout_dense(p, rep_l[g], pr->membres_colonne[pr->debut_colonne[h]]) - u;
+            if (c > INT32_MAX)
+                goto echec;
+            fixer_cout(q, g, h, c);
+            if (c < v[h])
+                v[h] = c;
+        }
+        pr->constante += u * q->provisions[g];
+        change |= (u != 0);
+    }
+    if (equilibre) {
+        for (int h = 0; h < m2; h++) {
+            pr->constante += v[h] * q->commandes[h];
+            change |= (v[h] != 0);
+        }
+        for (int g = 0; g < n2; g++)
+            for (int h = 0; h < m2; h++)
+                fixer_cout(q, g, h, cout_dense(q, g, h) - v[h]);
+    }
+    if (!change)
+        goto echec;
+
+    pr->couts_reduits = equilibre;
+    pr->reduit = q;
+    adapter_largeur_couts(q);
+    return pr;
+
+echec:
+    arene_revenir(a, marque);
+    return NULL;
+}
+
+/*
+ * Postrésolution -----------------------------------------------------------------
+ */
+
+typedef struct {
+    int i, j, flux;
+} CaseFlux;
+
+static int par_colonne(const void *a, const void *b)
+{
+    const CaseFlux *x = a, *y = b;
+    if (x->j != y->j)
+        return (x->j > y->j) - (x->j < y->j);
+    return (x->i > y->i) - (x->i < y->i);
+}
+
+static int par_ligne(const void *a, const void *b)
+{
+    const CaseFlux *x = a, *y = b;
+    if (x->i != y->i)
+        return (x->i > y->i) - (x->i < y->i);
+    return (x->j > y->j) - (x->j < y->j);
+}
+
+/* Répartit en escalier le flux des cases c[0..nb-1] d'un même groupe entre
+   ses membres, dans l'ordre : on ne quitte un membre qu'épuisé (reste[] :
+   quantité encore libre de chaque membre), le dernier prend ce qui reste.
+   Le membre remplace la colonne (sur_colonne) ou la ligne de la case.
+   Écrit au plus nb + nb_membres - 1 cases dans sortie ; renvoie leur nombre. */
+static int repartir(const CaseFlux *c, int nb, const int *membres, int nb_membres,
+                    int *reste, int sur_colonne, CaseFlux *sortie)
+{
+    int k = 0, nb_sortie = 0;
+    for (int t = 0; t < nb; t++) {
+        int flux = c[t].flux;
+        while (flux > 0) {
+            int e = membres[k];
+            int q = (k == nb_membres - 1 || reste[e] >= flux) ? flux : reste[e];
+            if (q > 0) {
+                sortie[nb_sortie] = c[t];
+                if (sur_colonne)
+                    sortie[nb_sortie].j = e;
+                else
+                    sortie[nb_sortie].i = e;
+                sortie[nb_sortie++].flux = q;
+                reste[e] -= q;
+                flux -= q;
+            }
+            if (flux > 0)
+                k++;
+        }
+    }
+    return nb_sortie;
+}
+
+int postresoudre(const Preresolution *pr, const Solution *reduite, Solution *s, Arene *a)
+{
+    const Probleme *p = pr->origine;
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    int nb = reduite->nb_cases;
+
+    // Pas de retour à une marque : s grandit dans la même arène
+    CaseFlux *cases = arene_alloc(a, ((size_t)nb + 1) * sizeof(CaseFlux));
+    CaseFlux *etape = arene_alloc(a, ((size_t)nb + m) * sizeof(CaseFlux));
+    CaseFlux *finales = arene_alloc(a, ((size_t)nb + m + n) * sizeof(CaseFlux));
+    int *reste_c = arene_alloc(a, (size_t)m * sizeof(int));
+    int *reste_p = arene_alloc(a, (size_t)n * sizeof(int));
+    if (!cases || !etape || !finales || !reste_c || !reste_p)
+        return -1;
+
+    for (int k = 0; k < nb; k++)
+        cases[k] = (CaseFlux){ reduite->case_i[k], reduite->case_j[k], reduite->flux[k] };
+    for (int j = 0; j < m; j++)
+        reste_c[j] = p->commandes[j];
+    for (int i = 0; i < n; i++)
+        reste_p[i] = p->provisions[i];
+
+    // Colonnes réduites -> clients
+    qsort(cases, (size_t)nb, sizeof(CaseFlux), par_colonne);
+    int nb_etape = 0;
+    for (int t = 0; t < nb;) {
+        int g = cases[t].j, u = t;
+        while (u < nb && cases[u].j == g)
+            u++;
+        nb_etape += repartir(cases + t, u - t,
+                             pr->membres_colonne + pr->debut_colonne[g],
+                             pr->debut_colonne[g + 1] - pr->debut_colonne[g],
+                             reste_c, 1, etape + nb_etape);
+        t = u;
+    }
+
+    // Lignes réduites -> fournisseurs
+    qsort(etape, (size_t)nb_etape, sizeof(CaseFlux), par_ligne);
+    int nb_finales = 0;
+    for (int t = 0; t < nb_etape;) {
+        int g = etape[t].i, u = t;
+        while (u < nb_etape && etape[u].i == g)
+            u++;
+        nb_finales += repartir(etape + t, u - t,
+                               pr->membres_ligne + pr->debut_ligne[g],
+                               pr->debut_ligne[g + 1] - pr->debut_ligne[g],
+                               reste_p, 0, finales + nb_finales);
+        t = u;
+    }
+
+    for (int k = 0; k < nb_finales; k++)
+        sol_ajouter(s, finales[k].i, finales[k].j, finales[k].flux);
+    return 0;
+}
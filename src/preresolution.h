@@ -0,0 +1,52 @@
+#ifndef PRERESOLUTION_H
+#define PRERESOLUTION_H
+
+#include "problem.h"
+#include "arene.h"
+
+/*
+ * Préresolution d'une matrice dense, avant la méthode initiale :
+ *  - les fournisseurs sans provision et les clients sans commande sont retirés ;
+ *  - les fournisseurs de coûts identiques (sur les clients gardés) forment
+ *    une seule ligne, de provision la somme des leurs ; de même pour les
+ *    clients de coûts identiques ;
+ *  - sur un problème équilibré, chaque ligne puis chaque colonne est
+ *    diminuée de son plus petit coût (a'_ij = a_ij - u_i - v_j) : tout
+ *    plan complet voit son coût baisser de la même constante, les bases
+ *    optimales ne changent donc pas, et les méthodes gloutonnes partent de
+ *    coûts relatifs.
+ *
+ * La postrésolution reporte la solution du problème réduit sur le problème
+ * d'origine : le flux d'une case réduite se répartit entre les membres de
+ * ses groupes en escalier, comme Nord-Ouest, ce qui garde une proposition
+ * de base (arbre) de même coût.
+ *
+ * Non applicable aux variantes creuse et implicite, aux coûts sur 64 bits,
+ * à la lecture par tuiles et au-delà de PRERESOLUTION_OCTETS_MAX pour la
+ * matrice réduite : preresoudre() renvoie alors NULL et p se résout tel quel.
+ */
+
+#define PRERESOLUTION_OCTETS_MAX ((size_t)256 << 20)
+
+typedef struct {
+    const Probleme *origine;
+    Probleme *reduit;
+    int *groupe_ligne;       // n : ligne réduite de chaque fournisseur, -1 si retiré
+    int *groupe_colonne;     // m : colonne réduite de chaque client, -1 si retiré
+    int *debut_ligne;        // n'+1 : fournisseurs de la ligne I dans membres_ligne[debut_ligne[I] ..]
+    int *membres_ligne;
+    int *debut_colonne;      // m'+1 : même principe par client
+    int *membres_colonne;
+    long long constante;     // coût d'origine = coût réduit + constante (problème équilibré)
+    int couts_reduits;       // 1 si les minima ont été soustraits
+} Preresolution;
+
+// Problème réduit alloué dans l'arène, ou NULL (rien à réduire, variante non
+// prise en charge, mémoire insuffisante)
+Preresolution *preresoudre(const Probleme *p, Arene *a);
+
+// Remplit s (solution vide du problème d'origine) à partir de la solution
+// du problème réduit. Renvoie 0, ou -1 si la mémoire manque.
+int postresoudre(const Preresolution *pr, const Solution *reduite, Solution *s, Arene *a);
+
+#endif
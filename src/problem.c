@@ -1,36 +1,262 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
 #include "problem.h"
 #include "trace.h"
+#include "utils.h"
+#include "io.h"
+#include "arene.h"
 
-Probleme *lire_probleme(const char *nom_fichier)
+Probleme *creer_probleme(int nb_fournisseurs, int nb_clients)
 {
-    FILE *f = fopen(nom_fichier, "r");
-    if (!f) return NULL;
+    return creer_probleme_largeur(nb_fournisseurs, nb_clients, sizeof(int32_t));
+}
 
-    Probleme *p = malloc(sizeof(Probleme));
+// Allocation dans l'arène a, ou par malloc si a est NULL
+static void *allouer_dans(Arene *a, size_t taille)
+{
+    return a ? arene_alloc(a, taille) : malloc(taille);
+}
 
-    fscanf(f, "%d %d", &p->nb_fournisseurs, &p->nb_clients);
+// Équivalent de realloc ; dans une arène, l'ancien tableau reste jusqu'au vidage
+static void *reallouer_dans(Arene *a, void *ancien, size_t ancienne_taille, size_t taille)
+{
+    if (!a)
+        return realloc(ancien, taille);
 
-    // Allocation matrice de coûts
-    p->couts = malloc(p->nb_fournisseurs * sizeof(int*));
-    for (int i = 0; i < p->nb_fournisseurs; i++)
-        p->couts[i] = malloc(p->nb_clients * sizeof(int));
+    void *nouveau = arene_alloc(a, taille);
+    if (nouveau && ancien)
+        memcpy(nouveau, ancien, ancienne_taille < taille ? ancienne_taille : taille);
+    return nouveau;
+}
 
-    p->provisions = malloc(p->nb_fournisseurs * sizeof(int));
-    p->commandes  = malloc(p->nb_clients * sizeof(int));
+Probleme *creer_probleme_dans(Arene *a, int nb_fournisseurs, int nb_clients)
+{
+    if (nb_fournisseurs <= 0 || nb_clients <= 0)
+        return NULL;
 
-    // Lecture du tableau
-    for (int i = 0; i < p->nb_fournisseurs; i++) {
-        for (int j = 0; j < p->nb_clients; j++)
-            fscanf(f, "%d", &p->couts[i][j]);
-        fscanf(f, "%d", &p->provisions[i]);
+    Probleme *p = arene_calloc(a, 1, sizeof(Probleme));
+    if (!p) return NULL;
+
+    p->arene           = a;
+    p->nb_fournisseurs = nb_fournisseurs;
+    p->nb_clients      = nb_clients;
+    p->largeur_couts   = sizeof(int32_t);
+    p->pas_couts       = pas_aligne(nb_clients, sizeof(int32_t));
+
+    size_t taille_couts = (size_t)nb_fournisseurs * p->pas_couts * sizeof(int32_t);
+    p->couts      = arene_alloc_aligne(a, taille_couts, ALIGNEMENT_MATRICE);
+    p->provisions = arene_calloc(a, (size_t)nb_fournisseurs, sizeof(int));
+    p->commandes  = arene_calloc(a, (size_t)nb_clients, sizeof(int));
+    if (!p->couts || !p->provisions || !p->commandes)
+        return NULL;
+
+    memset(p->couts, 0, taille_couts);
+    return p;
+}
+
+Probleme *creer_probleme_largeur(int nb_fournisseurs, int nb_clients, int largeur_couts)
+{
+    if (nb_fournisseurs <= 0 || nb_clients <= 0)
+        return NULL;
+    if (largeur_couts != 2 && largeur_couts != 4 && largeur_couts != 8)
+        return NULL;
+
+    Probleme *p = calloc(1, sizeof(Probleme));
+    if (!p) return NULL;
+
+    p->nb_fournisseurs = nb_fournisseurs;
+    p->nb_clients      = nb_clients;
+
+    // Un seul bloc aligné pour toute la matrice de coûts
+    p->largeur_couts = largeur_couts;
+    p->pas_couts  = pas_aligne(nb_clients, (size_t)largeur_couts);
+    p->couts      = allouer_bloc_aligne((size_t)nb_fournisseurs, (size_t)p->pas_couts, (size_t)largeur_couts);
+    p->provisions = calloc((size_t)nb_fournisseurs, sizeof(int));
+    p->commandes  = calloc((size_t)nb_clients, sizeof(int));
+
+    if (!p->couts || !p->provisions || !p->commandes) {
+        liberer_probleme(p);
+        return NULL;
     }
 
-    for (int j = 0; j < p->nb_clients; j++)
-        fscanf(f, "%d", &p->commandes[j]);
+    return p;
+}
+
+Probleme *creer_probleme_creux(int nb_fournisseurs, int nb_clients, int nb_arcs)
+{
+    if (nb_fournisseurs <= 0 || nb_clients <= 0 || nb_arcs < 0)
+        return NULL;
+
+    Probleme *p = calloc(1, sizeof(Probleme));
+    if (!p) return NULL;
+
+    p->nb_fournisseurs   = nb_fournisseurs;
+    p->nb_clients        = nb_clients;
+    p->nb_arcs_autorises = nb_arcs;
+
+    p->provisions      = calloc((size_t)nb_fournisseurs, sizeof(int));
+    p->commandes       = calloc((size_t)nb_clients, sizeof(int));
+    p->debut_ligne     = calloc((size_t)nb_fournisseurs + 1, sizeof(int));
+    p->debut_colonne   = calloc((size_t)nb_clients + 1, sizeof(int));
+    p->arc_client      = malloc(((size_t)nb_arcs + 1) * sizeof(int));
+    p->arc_cout        = malloc(((size_t)nb_arcs + 1) * sizeof(int));
+    p->arc_par_colonne = malloc(((size_t)nb_arcs + 1) * sizeof(int));
+    p->fournisseur_par_colonne = malloc(((size_t)nb_arcs + 1) * sizeof(int));
+
+    if (!p->provisions || !p->commandes || !p->debut_ligne || !p->debut_colonne ||
+        !p->arc_client || !p->arc_cout || !p->arc_par_colonne || !p->fournisseur_par_colonne) {
+        liberer_probleme(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+Probleme *creer_probleme_implicite(int nb_fournisseurs, int nb_clients, int metrique)
+{
+    if (nb_fournisseurs <= 0 || nb_clients <= 0 || metrique == METRIQUE_AUCUNE)
+        return NULL;
+
+    Probleme *p = calloc(1, sizeof(Probleme));
+    if (!p) return NULL;
+
+    p->nb_fournisseurs = nb_fournisseurs;
+    p->nb_clients      = nb_clients;
+    p->metrique        = metrique;
+
+    // Tableaux séparés x / y (structure de tableaux) pour les noyaux vectorisés
+    p->provisions = calloc((size_t)nb_fournisseurs, sizeof(int));
+    p->commandes  = calloc((size_t)nb_clients, sizeof(int));
+    p->x_f = allouer_bloc_aligne(1, (size_t)nb_fournisseurs, sizeof(double));
+    p->y_f = allouer_bloc_aligne(1, (size_t)nb_fournisseurs, sizeof(double));
+    p->x_c = allouer_bloc_aligne(1, (size_t)nb_clients, sizeof(double));
+    p->y_c = allouer_bloc_aligne(1, (size_t)nb_clients, sizeof(double));
+
+    if (!p->provisions || !p->commandes || !p->x_f || !p->y_f || !p->x_c || !p->y_c) {
+        liberer_probleme(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+/*
+ * Tri des lignes par client, en O(arcs + n + m) : un comptage par client
+ * range les arcs par (client, fournisseur) dans la vue transposée, puis
+ * chaque arc est recopié, dans cet ordre, à la suite de sa ligne. La vue
+ * transposée est ensuite réindexée sur les nouvelles positions.
+ */
+int finaliser_probleme_creux(Probleme *p)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    int nb = p->nb_arcs_autorises;
+    int cout_max = 0;
+
+    int *curseur = malloc(((size_t)(n > m ? n : m) + 1) * sizeof(int));
+    int *client = malloc(((size_t)nb + 1) * sizeof(int));
+    int *cout = malloc(((size_t)nb + 1) * sizeof(int));
+    if (!curseur || !client || !cout) {
+        free(curseur);
+        free(client);
+        free(cout);
+        return -1;
+    }
+
+    // Comptage par client, puis arcs d'origine rangés par (client, fournisseur)
+    for (int j = 0; j <= m; j++)
+        p->debut_colonne[j] = 0;
+    for (int k = 0; k < nb; k++)
+        p->debut_colonne[p->arc_client[k] + 1]++;
+    for (int j = 0; j < m; j++)
+        p->debut_colonne[j + 1] += p->debut_colonne[j];
+
+    for (int j = 0; j < m; j++)
+        curseur[j] = p->debut_colonne[j];
+    for (int i = 0; i < n; i++) {
+        for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++) {
+            int pos = curseur[p->arc_client[k]]++;
+            p->arc_par_colonne[pos] = k;
+            p->fournisseur_par_colonne[pos] = i;
+        }
+    }
+
+    // Recopie dans les lignes : chaque ligne reçoit ses arcs par client croissant
+    for (int i = 0; i < n; i++)
+        curseur[i] = p->debut_ligne[i];
+    for (int pos = 0; pos < nb; pos++) {
+        int k = p->arc_par_colonne[pos];
+        int t = curseur[p->fournisseur_par_colonne[pos]]++;
+        client[t] = p->arc_client[k];
+        cout[t] = p->arc_cout[k];
+        p->arc_par_colonne[pos] = t;
+    }
+    memcpy(p->arc_client, client, (size_t)nb * sizeof(int));
+    memcpy(p->arc_cout, cout, (size_t)nb * sizeof(int));
+    free(curseur);
+    free(client);
+    free(cout);
+
+    for (int i = 0; i < n; i++) {
+        for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++) {
+            if (k > p->debut_ligne[i] && p->arc_client[k] == p->arc_client[k - 1])
+                return -1;  // arc en double
+            if (p->arc_cout[k] > cout_max)
+                cout_max = p->arc_cout[k];
+        }
+    }
+
+    // Grand M : plus cher que tout chemin d'arcs autorisés, (cout_max + 1) x
+    // (n + m) ; les potentiels sont sur 64 bits, sans borne à INT_MAX.
+    p->cout_interdit = ((long long)cout_max + 1) * ((long long)n + m);
+
+    return 0;
+}
+
+// Position de l'arc (i,j) dans le stockage CSR, -1 si la paire est interdite
+static int indice_arc_creux(const Probleme *p, int i, int j)
+{
+    int bas = p->debut_ligne[i];
+    int haut = p->debut_ligne[i + 1] - 1;
+
+    while (bas <= haut) {
+        int milieu = (bas + haut) / 2;
+        int c = p->arc_client[milieu];
+        if (c == j) return milieu;
+        if (c < j) bas = milieu + 1;
+        else haut = milieu - 1;
+    }
+    return -1;
+}
+
+long long cout_arc_creux(const Probleme *p, int i, int j)
+{
+    int k = indice_arc_creux(p, i, j);
+    return (k >= 0) ? p->arc_cout[k] : p->cout_interdit;
+}
+
+int arc_autorise(const Probleme *p, int i, int j)
+{
+    return !est_creux(p) || indice_arc_creux(p, i, j) >= 0;
+}
+
+Probleme *lire_probleme(const char *nom_fichier)
+{
+    ErreurLecture err;
+    Probleme *p = est_fichier_binaire(nom_fichier)
+                ? charger_probleme_binaire(nom_fichier, &err)
+                : charger_probleme_texte(nom_fichier, &err);
+
+    if (!p) {
+        if (err.ligne > 0)
+            trace("%s:%d:%d : %s\n", nom_fichier, err.ligne, err.colonne, err.message);
+        else
+            trace("%s : %s\n", nom_fichier, err.message);
+    }
 
-    fclose(f);
     return p;
 }
 
@@ -41,8 +267,12 @@ void afficher_probleme(const Probleme *p)
            p->nb_fournisseurs, p->nb_clients);
 
     for (int i = 0; i < p->nb_fournisseurs; i++) {
-        for (int j = 0; j < p->nb_clients; j++)
-            trace("%4d ", p->couts[i][j]);
+        for (int j = 0; j < p->nb_clients; j++) {
+            if (arc_autorise(p, i, j))
+                trace("%4lld ", cout_arc(p, i, j));
+            else
+                trace("   . ");   // paire interdite (variante creuse)
+        }
         trace("| %d\n", p->provisions[i]);
     }
 
@@ -55,47 +285,213 @@ void afficher_probleme(const Probleme *p)
     trace("\n\n");
 }
 
-Solution *creer_solution_vide(const Probleme *p)
+Solution *creer_solution_vide_dans(const Probleme *p, Arene *a)
 {
-    Solution *s = malloc(sizeof(Solution));
+    Solution *s = allouer_dans(a, sizeof(Solution));
+    if (!s) return NULL;
+    memset(s, 0, sizeof(Solution));
+
+    s->arene           = a;
     s->nb_fournisseurs = p->nb_fournisseurs;
     s->nb_clients      = p->nb_clients;
 
-    s->x = malloc(s->nb_fournisseurs * sizeof(int*));
-    for (int i = 0; i < s->nb_fournisseurs; i++) {
-        s->x[i] = malloc(s->nb_clients * sizeof(int));
-        for (int j = 0; j < s->nb_clients; j++)
-            s->x[i][j] = 0;
+    // Une base compte n+m-1 cases ; la table grandit au besoin
+    s->capacite = p->nb_fournisseurs + p->nb_clients;
+    s->taille_index = 4;
+    while (s->taille_index < 2 * s->capacite)
+        s->taille_index *= 2;
+
+    s->case_i = allouer_dans(a, (size_t)s->capacite * sizeof(int));
+    s->case_j = allouer_dans(a, (size_t)s->capacite * sizeof(int));
+    s->flux   = allouer_dans(a, (size_t)s->capacite * sizeof(int));
+    s->index  = allouer_dans(a, (size_t)s->taille_index * sizeof(int));
+    if (!s->case_i || !s->case_j || !s->flux || !s->index) {
+        liberer_solution(s);
+        return NULL;
     }
 
+    for (int h = 0; h < s->taille_index; h++)
+        s->index[h] = -1;
+
     return s;
 }
 
+Solution *creer_solution_vide(const Probleme *p)
+{
+    return creer_solution_vide_dans(p, NULL);
+}
+
+static unsigned hacher_case(const Solution *s, int i, int j)
+{
+    unsigned long long cle = (unsigned long long)i * (unsigned)s->nb_clients + (unsigned)j;
+    return (unsigned)((cle * 0x9E3779B97F4A7C15ull) >> 32) & (unsigned)(s->taille_index - 1);
+}
+
+// Position dans l'index de la case (i,j), ou de l'emplacement libre où l'insérer
+static unsigned chercher_case(const Solution *s, int i, int j)
+{
+    unsigned h = hacher_case(s, i, j);
+    while (s->index[h] != -1) {
+        int k = s->index[h];
+        if (s->case_i[k] == i && s->case_j[k] == j)
+            break;
+        h = (h + 1) & (unsigned)(s->taille_index - 1);
+    }
+    return h;
+}
+
+static int agrandir_solution(Solution *s)
+{
+    int capacite = 2 * s->capacite;
+    int taille = 2 * s->taille_index;
+
+    size_t avant = (size_t)s->capacite * sizeof(int);
+    size_t apres = (size_t)capacite * sizeof(int);
+
+    int *ci = reallouer_dans(s->arene, s->case_i, avant, apres);
+    if (ci) s->case_i = ci;
+    int *cj = reallouer_dans(s->arene, s->case_j, avant, apres);
+    if (cj) s->case_j = cj;
+    int *fl = reallouer_dans(s->arene, s->flux, avant, apres);
+    if (fl) s->flux = fl;
+    int *index = allouer_dans(s->arene, (size_t)taille * sizeof(int));
+    if (!ci || !cj || !fl || !index) {
+        if (!s->arene)
+            free(index);
+        return -1;
+    }
+
+    if (!s->arene)
+        free(s->index);
+    s->index = index;
+    s->taille_index = taille;
+    s->capacite = capacite;
+    for (int h = 0; h < taille; h++)
+        s->index[h] = -1;
+    for (int k = 0; k < s->nb_cases; k++)
+        s->index[chercher_case(s, s->case_i[k], s->case_j[k])] = k;
+    return 0;
+}
+
+// Retire l'entrée h de l'index (sondage linéaire : on recompacte la suite)
+static void retirer_de_index(Solution *s, unsigned h)
+{
+    unsigned masque = (unsigned)(s->taille_index - 1);
+    s->index[h] = -1;
+
+    for (unsigned t = (h + 1) & masque; s->index[t] != -1; t = (t + 1) & masque) {
+        int k = s->index[t];
+        s->index[t] = -1;
+        s->index[chercher_case(s, s->case_i[k], s->case_j[k])] = k;
+    }
+}
+
+int sol_x(const Solution *s, int i, int j)
+{
+    int k = s->index[chercher_case(s, i, j)];
+    return (k >= 0) ? s->flux[k] : 0;
+}
+
+void sol_fixer(Solution *s, int i, int j, int q)
+{
+    unsigned h = chercher_case(s, i, j);
+    int k = s->index[h];
+
+    if (k >= 0) {
+        if (q != 0) {
+            s->flux[k] = q;
+            return;
+        }
+
+        // Suppression : la dernière case prend la place libérée
+        retirer_de_index(s, h);
+        int dernier = --s->nb_cases;
+        if (k != dernier) {
+            s->case_i[k] = s->case_i[dernier];
+            s->case_j[k] = s->case_j[dernier];
+            s->flux[k]   = s->flux[dernier];
+            s->index[chercher_case(s, s->case_i[k], s->case_j[k])] = k;
+        }
+        return;
+    }
+
+    if (q == 0)
+        return;
+
+    if (s->nb_cases == s->capacite) {
+        if (agrandir_solution(s) != 0)
+            return;
+        h = chercher_case(s, i, j);
+    }
+
+    k = s->nb_cases++;
+    s->case_i[k] = i;
+    s->case_j[k] = j;
+    s->flux[k]   = q;
+    s->index[h]  = k;
+}
+
+void sol_ajouter(Solution *s, int i, int j, int delta)
+{
+    if (delta != 0)
+        sol_fixer(s, i, j, sol_x(s, i, j) + delta);
+}
+
 void afficher_solution(const Probleme *p, const Solution *s)
 {
     trace("=== TABLEAU DE TRANSPORT ===\n");
     for (int i = 0; i < s->nb_fournisseurs; i++) {
         for (int j = 0; j < s->nb_clients; j++)
-            trace("%4d ", s->x[i][j]);
+            trace("%4d ", sol_x(s, i, j));
         trace("\n");
     }
     trace("\n");
 }
 
+long long cout_total(const Probleme *p, const Solution *s)
+{
+    long long total = 0;
+    for (int k = 0; k < s->nb_cases; k++)
+        total += (long long)s->flux[k] * cout_arc(p, s->case_i[k], s->case_j[k]);
+    return total;
+}
+
 void liberer_probleme(Probleme *p)
 {
-    for (int i = 0; i < p->nb_fournisseurs; i++)
-        free(p->couts[i]);
-    free(p->couts);
+    // Tout vit dans l'arène, rendue d'un coup par vider_arene()
+    if (!p || p->arene) return;
+
+    free(p->tuilage);
+
+    // Chargé sans copie depuis un fichier binaire : tout vit dans la projection
+    if (p->projection) {
+        munmap(p->projection, p->taille_projection);
+        free(p);
+        return;
+    }
+
+    liberer_bloc_aligne(p->couts);
     free(p->provisions);
     free(p->commandes);
+    free(p->debut_ligne);
+    free(p->arc_client);
+    free(p->arc_cout);
+    free(p->debut_colonne);
+    free(p->arc_par_colonne);
+    free(p->fournisseur_par_colonne);
+    liberer_bloc_aligne(p->x_f);
+    liberer_bloc_aligne(p->y_f);
+    liberer_bloc_aligne(p->x_c);
+    liberer_bloc_aligne(p->y_c);
     free(p);
 }
 
 void liberer_solution(Solution *s)
 {
-    for (int i = 0; i < s->nb_fournisseurs; i++)
-        free(s->x[i]);
-    free(s->x);
+    if (!s || s->arene) return;
+    free(s->case_i);
+    free(s->case_j);
+    free(s->flux);
+    free(s->index);
     free(s);
 }
\ No newline at end of file
@@ -1,26 +1,154 @@
 #ifndef PROBLEM_H
 #define PROBLEM_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef struct {
     int nb_fournisseurs;
     int nb_clients;
-    int **couts;         // matrice a_ij
+    int largeur_couts;   // octets par coût dans la matrice dense : 2, 4 ou 8 (cf. adapter_largeur_couts)
+    int pas_couts;       // nombre d'éléments par ligne de couts (>= nb_clients, aligné 64 octets)
+    void *couts;         // matrice a_ij, bloc contigu aligné : ligne i à i * pas_couts éléments
     int *provisions;     // P_i
     int *commandes;      // C_j
+    void *projection;    // fichier binaire projeté (mmap) si chargé sans copie, sinon NULL
+    size_t taille_projection;
+    struct Tuilage *tuilage;   // lecture par tuiles (cf. tuiles.h), NULL : matrice lue en entier
+    struct Arene *arene;       // arène propriétaire de la mémoire, NULL : malloc
+
+    // Variante creuse (couts == NULL) : seuls les arcs autorisés sont stockés (CSR).
+    // Une paire absente coûte cout_interdit (arc artificiel, "grand M").
+    int nb_arcs_autorises;
+    int *debut_ligne;      // n+1 : arcs de F_i dans [debut_ligne[i], debut_ligne[i+1][
+    int *arc_client;       // client de chaque arc (trié par client dans chaque ligne)
+    int *arc_cout;         // coût de chaque arc
+    int *debut_colonne;    // m+1 : vue transposée, même principe par client
+    int *arc_par_colonne;  // indices d'arcs triés par client puis par fournisseur
+    int *fournisseur_par_colonne;  // fournisseur de chaque entrée de arc_par_colonne
+    long long cout_interdit;   // (cout_max + 1) x (n + m), cf. finaliser_probleme_creux
+
+    // Variante implicite (couts == NULL, metrique != METRIQUE_AUCUNE) : le coût
+    // est la distance entre les sites, recalculée à la demande (mémoire O(n+m)).
+    int metrique;
+    double *x_f, *y_f;     // coordonnées des fournisseurs
+    double *x_c, *y_c;     // coordonnées des clients
 } Probleme;
 
+enum {
+    METRIQUE_AUCUNE = 0,   // coûts stockés (dense ou creux)
+    METRIQUE_L1,           // |dx| + |dy|
+    METRIQUE_L2,           // partie entière de la distance euclidienne
+    METRIQUE_L2_ARRONDI    // distance euclidienne arrondie à l'entier le plus proche
+};
+
+// Une proposition de base n'a qu'au plus n+m-1 cases non nulles : on ne
+// stocke que celles-ci (mémoire O(n+m)). Une case absente vaut 0.
 typedef struct {
     int nb_fournisseurs;
     int nb_clients;
-    int **x;             // quantités transportées b_ij
+    int nb_cases;        // nombre de cases non nulles
+    int capacite;
+    int *case_i;         // case k : (case_i[k], case_j[k]) transporte flux[k] > 0
+    int *case_j;
+    int *flux;
+    int *index;          // table de hachage (i,j) -> k, adressage ouvert, -1 si libre
+    int taille_index;    // puissance de 2, au moins le double de capacite
+    struct Arene *arene; // arène propriétaire des tableaux, NULL : malloc
 } Solution;
 
+// Quantité b_ij (0 si la case n'est pas stockée)
+int sol_x(const Solution *s, int i, int j);
+
+// b_ij = q ; une quantité nulle retire la case
+void sol_fixer(Solution *s, int i, int j, int q);
+
+// b_ij += delta
+void sol_ajouter(Solution *s, int i, int j, int delta);
+
+// Début de la ligne i de la matrice dense (aligné sur 64 octets), à la largeur stockée
+static inline void *ligne_couts(const Probleme *p, int i)
+{
+    return (char *)p->couts + (size_t)i * p->pas_couts * p->largeur_couts;
+}
+
+// Coût (i,j) de la matrice dense, quelle que soit sa largeur
+static inline long long cout_dense(const Probleme *p, int i, int j)
+{
+    const void *ligne = ligne_couts(p, i);
+    switch (p->largeur_couts) {
+    case 2:  return ((const int16_t *)ligne)[j];
+    case 8:  return ((const int64_t *)ligne)[j];
+    default: return ((const int32_t *)ligne)[j];
+    }
+}
+
+static inline void fixer_cout(Probleme *p, int i, int j, long long c)
+{
+    void *ligne = ligne_couts(p, i);
+    switch (p->largeur_couts) {
+    case 2:  ((int16_t *)ligne)[j] = (int16_t)c; break;
+    case 8:  ((int64_t *)ligne)[j] = c;          break;
+    default: ((int32_t *)ligne)[j] = (int32_t)c; break;
+    }
+}
+
+static inline int est_creux(const Probleme *p)
+{
+    return p->debut_ligne != NULL;
+}
+
+static inline int est_implicite(const Probleme *p)
+{
+    return p->metrique != METRIQUE_AUCUNE;
+}
+
+// Coût de (i,j) dans la variante implicite (défini dans couts.c)
+int cout_implicite(const Probleme *p, int i, int j);
+
+// Coût de (i,j) dans la variante creuse : recherche dichotomique dans la ligne i
+long long cout_arc_creux(const Probleme *p, int i, int j);
+
+// Coût de (i,j) quelle que soit la représentation (lecture seule)
+static inline long long cout_arc(const Probleme *p, int i, int j)
+{
+    if (p->couts)
+        return cout_dense(p, i, j);
+    if (est_creux(p))
+        return cout_arc_creux(p, i, j);
+    return cout_implicite(p, i, j);
+}
+
+// 1 si (i,j) est un arc autorisé (toujours vrai pour un problème dense)
+int arc_autorise(const Probleme *p, int i, int j);
+
+// Alloue un problème n x m (coûts et quantités à 0), coûts sur 32 bits ;
+// adapter_largeur_couts() (couts.h) réduit ensuite la largeur si possible.
+Probleme *creer_probleme(int nb_fournisseurs, int nb_clients);
+// Problème dense (coûts sur 32 bits) alloué dans une arène : rendu par vider_arene()
+Probleme *creer_probleme_dans(struct Arene *a, int nb_fournisseurs, int nb_clients);
+Probleme *creer_probleme_largeur(int nb_fournisseurs, int nb_clients, int largeur_couts);
+
+// Alloue un problème creux ; les arcs sont à remplir par l'appelant,
+// puis finaliser_probleme_creux() trie les lignes et construit la vue par colonne.
+Probleme *creer_probleme_creux(int nb_fournisseurs, int nb_clients, int nb_arcs);
+int finaliser_probleme_creux(Probleme *p);
+
+// Alloue un problème à coûts implicites ; coordonnées et quantités à remplir par l'appelant
+Probleme *creer_probleme_implicite(int nb_fournisseurs, int nb_clients, int metrique);
+
 Probleme *lire_probleme(const char *nom_fichier);
 void afficher_probleme(const Probleme *p);
 
 Solution *creer_solution_vide(const Probleme *p);
+Solution *creer_solution_vide_dans(const Probleme *p, struct Arene *a);
+
+// Seul affichage qui reconstitue le tableau dense n x m
 void afficher_solution(const Probleme *p, const Solution *s);
 
+// Coût total sum(a_ij * b_ij), accumulé sur 64 bits
+long long cout_total(const Probleme *p, const Solution *s);
+
 void liberer_probleme(Probleme *p);
 void liberer_solution(Solution *s);
 
@@ -0,0 +1,276 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "russell.h"
+#include "couts.h"
+#include "tas.h"
+#include "trace.h"
+#include "annulation.h"
+
+static int minimum(int a, int b) { return (a < b) ? a : b; }
+
+/*
+ * L'écart se sépare : min_j (c_ij - u_i - v_j) = ecart_i - u_i, avec
+ * ecart_i = min_j (c_ij - v_j) sur les colonnes actives. Chaque ligne active
+ * garde u_i, ecart_i et leurs colonnes, et le tas range les lignes par
+ * ecart_i - u_i (à égalité la plus petite ligne, puis la plus petite colonne).
+ *
+ * Rayer des cases ne fait que baisser les maxima u et v :
+ *  - rayer la colonne j ne change que les lignes dont u_i ou ecart_i
+ *    tombait en j ;
+ *  - rayer la ligne r ne change que les v_j atteints en r ; v_j baissant,
+ *    c_ij - v_j augmente pour tout i, et seules les lignes dont ecart_i
+ *    tombait en une telle colonne sont à recalculer.
+ * Le maximum perdu reste le maximum s'il réapparaît plus loin (coûts égaux,
+ * fréquents sur de petites plages de valeurs) : on cherche d'abord cette
+ * égalité avant de relire toute la ligne ou la colonne.
+ */
+
+// Valeur de moins_v d'une colonne rayée. Elle ne suffit pas à l'écarter des
+// minima (un coût négatif ramène c + GRAND sous GRAND) : colonne_active est
+// testée explicitement.
+#define GRAND (LLONG_MAX / 4)
+
+typedef struct {
+    const Probleme *p;
+    int n, m;
+    int *ligne_active;
+    int *colonne_active;
+    long long *u, *v;        // plus grands coûts actifs de chaque ligne / colonne
+    int *arg_u, *arg_v;
+    long long *ecart;        // min_j (c_ij - v_j) sur les colonnes actives
+    int *arg_ecart;
+    long long *moins_v;      // -v_j, ou GRAND pour une colonne rayée
+    int *modifiee;           // colonnes dont v vient de baisser
+    long long *ligne;        // ligne de coûts copiée (64 bits)
+    long long *colonne;      // colonne de coûts copiée
+    int *tampon;
+    Tas file;                // lignes actives par ecart_i - u_i croissant
+} EtatRussell;
+
+// Recalcule u_i, ecart_i et la clé de la ligne i active, ou la retire du tas
+// si elle n'a plus de colonne active
+static void recalculer_ligne(EtatRussell *e, int i)
+{
+    copier_ligne_couts(e->p, i, e->tampon, e->ligne);
+
+    long long u = LLONG_MIN, ecart = GRAND;
+    int arg_u = -1, arg_ecart = -1;
+    for (int j = 0; j < e->m; j++) {
+        long long c = e->ligne[j];
+        if (e->colonne_active[j] && c > u) {
+            u = c;
+            arg_u = j;
+        }
+        if (e->colonne_active[j] && c + e->moins_v[j] < ecart) {
+            ecart = c + e->moins_v[j];
+            arg_ecart = j;
+        }
+    }
+
+    e->u[i] = u;
+    e->arg_u[i] = arg_u;
+    e->ecart[i] = ecart;
+    e->arg_ecart[i] = arg_ecart;
+    if (arg_ecart < 0)
+        tas_retirer(&e->file, i);
+    else
+        tas_placer(&e->file, i, ecart - u);
+}
+
+// Première position active après arg, sur la ligne i (ou la colonne j), dont
+// le coût vaut encore le maximum, -1 sinon
+static int maximum_suivant_ligne(const EtatRussell *e, int i, int arg, long long max)
+{
+    for (int j = arg + 1; j < e->m; j++)
+        if (e->colonne_active[j] && cout_arc(e->p, i, j) == max)
+            return j;
+    return -1;
+}
+
+static int maximum_suivant_colonne(const EtatRussell *e, int j, int arg, long long max)
+{
+    for (int i = arg + 1; i < e->n; i++)
+        if (e->ligne_active[i] && cout_arc(e->p, i, j) == max)
+            return i;
+    return -1;
+}
+
+// Recalcule v_j sur les lignes actives, sa ligne arg_v venant d'être rayée ;
+// renvoie 1 si v_j a changé
+static int recalculer_colonne(EtatRussell *e, int j)
+{
+    int suivant = maximum_suivant_colonne(e, j, e->arg_v[j], e->v[j]);
+    if (suivant >= 0) {
+        e->arg_v[j] = suivant;
+        return 0;
+    }
+
+    copier_colonne_couts(e->p, j, e->tampon, e->colonne);
+
+    long long v = LLONG_MIN;
+    int arg_v = -1;
+    for (int i = 0; i < e->n; i++) {
+        if (e->ligne_active[i] && e->colonne[i] > v) {
+            v = e->colonne[i];
+            arg_v = i;
+        }
+    }
+
+    int change = (v != e->v[j]);
+    e->v[j] = v;
+    e->arg_v[j] = arg_v;
+    e->moins_v[j] = (arg_v >= 0) ? -v : GRAND;
+    return change;
+}
+
+static void rayer_colonne(EtatRussell *e, int j)
+{
+    e->colonne_active[j] = 0;
+    e->moins_v[j] = GRAND;
+
+    for (int i = 0; i < e->n; i++) {
+        if (!e->ligne_active[i])
+            continue;
+        if (e->arg_ecart[i] == j) {
+            recalculer_ligne(e, i);
+        } else if (e->arg_u[i] == j) {
+            // ecart_i ne tombait pas en j : seul u_i peut changer
+            int suivant = maximum_suivant_ligne(e, i, j, e->u[i]);
+            if (suivant >= 0)
+                e->arg_u[i] = suivant;
+            else
+                recalculer_ligne(e, i);
+        }
+    }
+}
+
+static void rayer_ligne(EtatRussell *e, int r)
+{
+    e->ligne_active[r] = 0;
+    tas_retirer(&e->file, r);
+
+    int nb_modifiees = 0;
+    for (int j = 0; j < e->m; j++) {
+        e->modifiee[j] = 0;
+        if (e->colonne_active[j] && e->arg_v[j] == r && recalculer_colonne(e, j)) {
+            e->modifiee[j] = 1;
+            nb_modifiees++;
+        }
+    }
+    if (nb_modifiees == 0)
+        return;
+
+    for (int i = 0; i < e->n; i++)
+        if (e->ligne_active[i] && e->arg_ecart[i] >= 0 && e->modifiee[e->arg_ecart[i]])
+            recalculer_ligne(e, i);
+}
+
+void russell(const Probleme *p, Solution *s)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+
+    EtatRussell e = { 0 };
+    e.p = p;
+    e.n = n;
+    e.m = m;
+
+    int *provisions = malloc((size_t)n * sizeof(int));
+    int *commandes = malloc((size_t)m * sizeof(int));
+    e.ligne_active = malloc((size_t)n * sizeof(int));
+    e.colonne_active = malloc((size_t)m * sizeof(int));
+    e.u = malloc((size_t)n * sizeof(long long));
+    e.arg_u = malloc((size_t)n * sizeof(int));
+    e.ecart = malloc((size_t)n * sizeof(long long));
+    e.arg_ecart = malloc((size_t)n * sizeof(int));
+    e.v = malloc((size_t)m * sizeof(long long));
+    e.arg_v = malloc((size_t)m * sizeof(int));
+    e.moins_v = malloc((size_t)m * sizeof(long long));
+    e.modifiee = malloc((size_t)m * sizeof(int));
+    e.ligne = malloc((size_t)m * sizeof(long long));
+    e.colonne = malloc((size_t)n * sizeof(long long));
+    e.tampon = malloc((size_t)taille_tampon_couts(p) * sizeof(int));
+
+    if (!provisions || !commandes || !e.ligne_active || !e.colonne_active ||
+        !e.u || !e.arg_u || !e.ecart || !e.arg_ecart || !e.v || !e.arg_v ||
+        !e.moins_v || !e.modifiee || !e.ligne || !e.colonne || !e.tampon ||
+        initialiser_tas(&e.file, n) != 0) {
+        trace("Erreur Russell : mémoire insuffisante.\n");
+        goto fin;
+    }
+
+    trace("\n--- Déroulé de la méthode de Russell ---\n\n");
+
+    // Une ligne ou colonne sans quantité est rayée d'emblée
+    for (int i = 0; i < n; i++) {
+        provisions[i] = p->provisions[i];
+        e.ligne_active[i] = (provisions[i] > 0);
+    }
+    for (int j = 0; j < m; j++) {
+        commandes[j] = p->commandes[j];
+        e.colonne_active[j] = (commandes[j] > 0);
+        e.v[j] = LLONG_MIN;
+        e.arg_v[j] = -1;
+    }
+
+    // Maxima des colonnes en parcourant les lignes (lecture contiguë)
+    for (int i = 0; i < n; i++) {
+        if (!e.ligne_active[i])
+            continue;
+        copier_ligne_couts(p, i, e.tampon, e.ligne);
+        for (int j = 0; j < m; j++) {
+            if (e.ligne[j] > e.v[j]) {
+                e.v[j] = e.ligne[j];
+                e.arg_v[j] = i;
+            }
+        }
+    }
+    for (int j = 0; j < m; j++)
+        e.moins_v[j] = (e.colonne_active[j] && e.arg_v[j] >= 0) ? -e.v[j] : GRAND;
+
+    for (int i = 0; i < n; i++)
+        if (e.ligne_active[i])
+            recalculer_ligne(&e, i);
+
+    while (!tas_vide(&e.file) && !methode_annulee()) {
+        int i = tas_sommet(&e.file);
+        int j = e.arg_ecart[i];
+        trace("Écart minimal : %lld → case (%d,%d)\n", e.file.cle[i], i, j);
+
+        int q = minimum(provisions[i], commandes[j]);
+        sol_fixer(s, i, j, q);
+
+        trace("Remplissage de la case (%d,%d) avec %d unités (coût %lld)\n",
+               i, j, q, cout_arc(p, i, j));
+
+        provisions[i] -= q;
+        commandes[j] -= q;
+
+        // Une quantité épuisée raye sa ligne ou sa colonne (les deux à égalité)
+        if (provisions[i] == 0)
+            rayer_ligne(&e, i);
+        if (commandes[j] == 0)
+            rayer_colonne(&e, j);
+    }
+
+    trace("\n--- Fin de la méthode de Russell ---\n\n");
+
+fin:
+    free(provisions);
+    free(commandes);
+    free(e.ligne_active);
+    free(e.colonne_active);
+    free(e.u);
+    free(e.arg_u);
+    free(e.ecart);
+    free(e.arg_ecart);
+    free(e.v);
+    free(e.arg_v);
+    free(e.moins_v);
+    free(e.modifiee);
+    free(e.ligne);
+    free(e.colonne);
+    free(e.tampon);
+    liberer_tas(&e.file);
+}
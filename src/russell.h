@@ -0,0 +1,11 @@
+#ifndef RUSSELL_H
+#define RUSSELL_H
+
+#include "problem.h"
+
+// Proposition initiale par la méthode d'approximation de Russell : remplit à
+// chaque étape la case active de plus petit écart c_ij - u_i - v_j, où u_i et
+// v_j sont les plus grands coûts actifs de la ligne i et de la colonne j.
+void russell(const Probleme *p, Solution *s);
+
+#endif
@@ -0,0 +1,588 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include "transport.h"
+#include "heuristiques.h"
+#include "portefeuille.h"
+#include "caracteristiques.h"
+#include "choix_methode.h"
+#include "preresolution.h"
+#include "petit_probleme.h"
+#include "potentiel.h"
+#include "marche_pied.h"
+#include "tarification.h"
+#include "base.h"
+#include "tuiles.h"
+#include "arene.h"
+#include "trace.h"
+
+struct ContexteTransport {
+    SortieTrace sortie;   // destinations des traces pendant la résolution
+    int detaille;         // 1 : affichages par itération
+    int nb_threads;       // threads de la méthode initiale, 0 : un par cœur
+    double delai_portefeuille;  // mode portefeuille : délai maximal (s), 0 : aucun
+    int preresolution;    // 1 : réduction du problème avant la méthode initiale
+    int tarification;     // choix de l'arc entrant (tarification.h)
+    int tarification_imposee;  // 1 : fixée par l'appelant, auto ne la change pas
+    TableChoix table_choix;    // règles du choix automatique (choix_methode.h)
+    Arene *arene;         // solution et tableaux de travail, vidée à chaque résolution
+};
+
+/* Temps CPU du thread courant : la mesure reste juste quand plusieurs
+   résolutions tournent en parallèle (clock() compte tout le processus). */
+static double temps_cpu(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/* Temps écoulé : seul comparable d'un nombre de threads à l'autre. */
+static double temps_reel(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/*
+ * Résolution compacte : marche-pied ----------------------------------------
+ */
+
+static int marche_pied_silencieux(const ArbreBase *t, const AdjacenceBase *adj, Solution *s,
+                                  int i_entree, int j_entree,
+                                  int *i_sortie_ptr, int *j_sortie_ptr, Arene *a)
+{
+    int n = s->nb_fournisseurs;
+    int total = n + s->nb_clients;
+
+    /* Tout le travail du pivot est rendu à l'arène en sortie */
+    MarqueArene marque = arene_marque(a);
+    int theta = -1;
+    int i_sortie = -1;
+    int j_sortie = -1;
+
+    int *chemin_noeuds = arene_alloc(a, (size_t)total * sizeof(int));
+    int *travail = arene_alloc(a, 2 * (size_t)total * sizeof(int));  // parcours de secours
+    if (!chemin_noeuds || !travail)
+        goto fin;
+
+    int len = chemin_du_cycle(t, adj, i_entree, j_entree, chemin_noeuds, travail);
+    if (len < 0)
+        goto fin;
+
+    int cycle_taille = len;
+    int *cycle_i = arene_alloc(a, (size_t)cycle_taille * sizeof(int));
+    int *cycle_j = arene_alloc(a, (size_t)cycle_taille * sizeof(int));
+    int *signe = arene_alloc(a, (size_t)cycle_taille * sizeof(int));
+    if (!cycle_i || !cycle_j || !signe)
+        goto fin;
+
+    cycle_i[0] = i_entree;
+    cycle_j[0] = j_entree;
+
+    for (int e = 0; e < len - 1; e++) {
+        int u = chemin_noeuds[e];
+        int v = chemin_noeuds[e + 1];
+        int fi, cj;
+
+        if (u < n && v >= n) {
+            fi = u;
+            cj = v - n;
+        } else if (v < n && u >= n) {
+            fi = v;
+            cj = u - n;
+        } else {
+            goto fin;
+        }
+
+        cycle_i[e + 1] = fi;
+        cycle_j[e + 1] = cj;
+    }
+
+    for (int e = 0; e < cycle_taille; e++)
+        signe[e] = (e % 2 == 0) ? 1 : -1;
+
+    theta = INT_MAX;
+    for (int e = 0; e < cycle_taille; e++) {
+        if (signe[e] == -1) {
+            int x = sol_x(s, cycle_i[e], cycle_j[e]);
+            if (x < theta)
+                theta = x;
+        }
+    }
+
+    if (theta == INT_MAX)
+        theta = 0;
+
+    for (int e = 0; e < cycle_taille; e++)
+        sol_ajouter(s, cycle_i[e], cycle_j[e], signe[e] * theta);
+
+    for (int e = 0; e < cycle_taille; e++) {
+        if (signe[e] == -1 && sol_x(s, cycle_i[e], cycle_j[e]) == 0) {
+            i_sortie = cycle_i[e];
+            j_sortie = cycle_j[e];
+            break;
+        }
+    }
+
+fin:
+    if (i_sortie_ptr)
+        *i_sortie_ptr = i_sortie;
+    if (j_sortie_ptr)
+        *j_sortie_ptr = j_sortie;
+
+    arene_revenir(a, marque);
+    return theta;
+}
+
+/* Renvoie le temps de l'optimisation ; *nb_iterations reçoit le nombre de passes de tarification. */
+static double optimiser_par_marche_pied(const Probleme *p, Solution *s, Arene *a,
+                                        int strategie, int *nb_iterations)
+{
+    int n = p->nb_fournisseurs;
+    int m = p->nb_clients;
+    MarqueArene marque = arene_marque(a);
+    long long *pot_f = arene_alloc(a, (size_t)n * sizeof(long long));
+    long long *pot_c = arene_alloc(a, (size_t)m * sizeof(long long));
+    ArbreBase *arbre = creer_arbre_base(n, m, a);
+    Tarification *tarif = creer_tarification(p, strategie, a);
+
+    if (!pot_f || !pot_c || !arbre || !tarif) {
+        arene_revenir(a, marque);
+        return -1.0;
+    }
+
+    /* Les bases successives s'empilent au-dessus de cette marque */
+    MarqueArene debut_bases = arene_marque(a);
+    int capacite_solution = s->capacite;
+
+    Base *b = construire_base_dans(s, a);
+    if (!b) {
+        arene_revenir(a, marque);
+        return -1.0;
+    }
+
+    double debut = temps_cpu();
+
+    int iteration = 0;
+    int optimal = 0;
+    const int iteration_max = n * m * 2; /* borne de sécurité */
+
+    while (!optimal && iteration < iteration_max) {
+        iteration++;
+
+        /* Tant que l'arbre suit la base (pivots), ni vérification, ni
+           adjacence, ni potentiels complets ; sinon, après une
+           reconstruction de la base, on repart de zéro. L'adjacence est
+           rendue après le pivot si la solution n'a pas grandi au-dessus. */
+        MarqueArene marque_adjacence = arene_marque(a);
+        int capacite_pivot = s->capacite;
+        AdjacenceBase *adj = NULL;
+        if (arbre->racine < 0) {
+            if (!base_est_arbre(b, n, m)) {
+                b = corriger_base_dans(b, s, n, m, a);
+                if (!b)
+                    break;
+                marque_adjacence = arene_marque(a);
+                capacite_pivot = s->capacite;
+            }
+            adj = construire_adjacence_dans(b, n, m, a);
+            if (!adj)
+                break;
+            enraciner_potentiels(arbre, p, adj, pot_f, pot_c);
+        }
+
+        int i_entree = -1;
+        int j_entree = -1;
+        optimal = choisir_arc_entrant(tarif, p, b, pot_f, pot_c, &i_entree, &j_entree);
+        if (optimal)
+            break;
+        long long marginal = cout_arc(p, i_entree, j_entree) - (pot_f[i_entree] - pot_c[j_entree]);
+
+        int i_sortie = -1;
+        int j_sortie = -1;
+        int theta = marche_pied_silencieux(arbre, adj, s, i_entree, j_entree, &i_sortie, &j_sortie, a);
+
+        /* Place de l'arc sortant : lue dans l'arbre, sinon dans l'index de la base */
+        int k_sortie = -1;
+        if (theta >= 0 && i_sortie >= 0 && j_sortie >= 0) {
+            k_sortie = arc_dans_arbre(arbre, i_sortie, j_sortie);
+            if (k_sortie < 0)
+                k_sortie = base_chercher_arc(b, i_sortie, j_sortie);
+        }
+        int remplace = (k_sortie >= 0);
+        if (remplace) {
+            base_remplacer_arc(b, k_sortie, i_entree, j_entree);
+            mettre_a_jour_potentiels(arbre, i_entree, j_entree, i_sortie, j_sortie,
+                                     marginal, pot_f, pot_c);
+        } else {
+            invalider_arbre_base(arbre);
+        }
+
+        if (s->capacite == capacite_pivot)
+            arene_revenir(a, marque_adjacence);
+
+        if (theta < 0)
+            break;
+
+        if (!remplace) {
+            /* Les anciennes bases sont rendues, sauf si la solution a grandi
+               depuis dans l'arène (ses tableaux sont alors au-dessus) */
+            if (s->capacite == capacite_solution)
+                arene_revenir(a, debut_bases);
+            b = construire_base_dans(s, a);
+            if (!b)
+                break;
+        }
+    }
+
+    double fin = temps_cpu();
+
+    if (s->capacite == capacite_solution)
+        arene_revenir(a, marque);
+
+    if (nb_iterations)
+        *nb_iterations = iteration;
+
+    return fin - debut;
+}
+
+/*
+ * Résolution détaillée (affichages du programme transport) ------------------
+ */
+
+static void resoudre_detaille(const Probleme *p, Solution *s, int strategie,
+                              ResultatTransport *res)
+{
+    trace("\n=== SOLUTION DE DÉPART ===\n");
+    afficher_solution(p, s);
+
+    // === Construction initiale de la base ===
+    Base *b = construire_base(s);
+
+    //  Potentiels + coûts marginaux + marche-pied (boucle complète)
+    long long *pot_f = malloc(sizeof(long long) * (size_t)p->nb_fournisseurs);
+    long long *pot_c = malloc(sizeof(long long) * (size_t)p->nb_clients);
+    ArbreBase *arbre = creer_arbre_base(p->nb_fournisseurs, p->nb_clients, NULL);
+    Tarification *tarif = creer_tarification(p, strategie, NULL);
+    if (!pot_f || !pot_c || !arbre || !tarif) {
+        trace("Erreur : mémoire insuffisante pour les potentiels.\n");
+        free(pot_f);
+        free(pot_c);
+        liberer_arbre_base(arbre);
+        liberer_tarification(tarif);
+        liberer_base(b);
+        return;
+    }
+
+    int i_entree, j_entree;
+    int i_sortie, j_sortie;
+    int optimal = 0;
+    int iteration = 1;
+    double time_spent_mp=0.0;
+
+    // c'est pas bon ici je pense 
+    while (1) {
+        trace("\n================== ITERATION %d ==================\n", iteration++);
+
+        // (Re)affichage de la base courante
+        afficher_base_liste(b);  // debug textuel
+        afficher_base_graphe(b, p->nb_fournisseurs, p->nb_clients);  // dessin style S/T
+
+        // Vérification/correction de la base à chaque itération pour que les potentiels soient cohérents
+        if (base_est_arbre(b, p->nb_fournisseurs, p->nb_clients)) {
+            trace("\n>>> La base est un arbre. OK pour les potentiels.\n");
+        } else {
+            trace("\n>>> La base n'est PAS un arbre ! Correction nécessaire.\n");
+            trace("\n>>> Correction automatique de la base...\n");
+
+            Base *b2 = corriger_base(b, s,
+                                     p->nb_fournisseurs,
+                                     p->nb_clients);
+
+            liberer_base(b);
+            b = b2;
+            invalider_arbre_base(arbre);
+
+            trace("\n--- Nouvelle base après correction ---\n");
+            afficher_base_liste(b);
+            afficher_base_graphe(b,
+                                 p->nb_fournisseurs,
+                                 p->nb_clients);
+        }
+
+        // 1) Potentiels, sur l'adjacence de la base (aussi utilisée par le marche-pied) :
+        //    complets après une reconstruction, sinon ceux mis à jour au pivot
+        //    précédent, ramenés à la même origine que le calcul complet
+        AdjacenceBase *adj = construire_adjacence(b, p->nb_fournisseurs, p->nb_clients);
+        if (!adj) {
+            trace("Erreur : mémoire insuffisante pour les potentiels.\n");
+            break;
+        }
+        if (arbre->racine < 0)
+            enraciner_potentiels(arbre, p, adj, pot_f, pot_c);
+        else
+            normaliser_potentiels(adj, pot_f, pot_c);
+        afficher_potentiels(p, pot_f, pot_c);
+        afficher_table_couts_potentiels(p, pot_f, pot_c);
+
+        // 2) Coûts marginaux + choix de l'arête améliorante
+        optimal = calculer_et_afficher_couts_marginaux(p, s, b,
+                                                       pot_f, pot_c,
+                                                       &i_entree, &j_entree);
+
+        // Hors Dantzig, l'arc entrant est celui de la stratégie choisie
+        if (!optimal && strategie != TARIFICATION_DANTZIG &&
+            !choisir_arc_entrant(tarif, p, b, pot_f, pot_c, &i_entree, &j_entree)) {
+            trace("Tarification %s : arc entrant (F%d, C%d), coût marginal %lld\n",
+                  nom_tarification(strategie), i_entree, j_entree,
+                  cout_arc(p, i_entree, j_entree) - (pot_f[i_entree] - pot_c[j_entree]));
+        }
+
+        // 3) Marche-pied si ce n'est pas optimal
+        if (!optimal) {
+            trace("\n=== MARCHE-PIED SUR L'ARÊTE AMÉLIORANTE (F%d, C%d) ===\n",
+                   i_entree, j_entree);
+            long long marginal = cout_arc(p, i_entree, j_entree) - (pot_f[i_entree] - pot_c[j_entree]);
+            double debut = temps_cpu();
+            i_sortie = -1;
+            j_sortie = -1;
+            int theta_mp = marche_pied(arbre, adj, s, i_entree, j_entree, &i_sortie, &j_sortie);
+            double fin = temps_cpu();
+
+            trace("\n=== NOUVELLE SOLUTION APRÈS MARCHE-PIED ===\n");
+            afficher_solution(p, s);
+
+            time_spent_mp += fin - debut;
+
+            if (theta_mp == 0) {
+                trace("Pivot dégénéré (theta = 0) : mise à jour de la base pour changer de proposition.\n");
+            }
+
+            // Mettre à jour la base en remplaçant l'arc sortant par l'arc entrant,
+            // même en cas de pivot dégénéré (theta = 0) pour éviter de boucler.
+            // La place de l'arc sortant est lue dans l'arbre quand il suit la base,
+            // sinon dans l'index de la base.
+            int k_sortie = -1;
+            if (i_sortie >= 0 && j_sortie >= 0) {
+                k_sortie = arc_dans_arbre(arbre, i_sortie, j_sortie);
+                if (k_sortie < 0)
+                    k_sortie = base_chercher_arc(b, i_sortie, j_sortie);
+            }
+            int remplace = (k_sortie >= 0);
+
+            if (remplace) {
+                base_remplacer_arc(b, k_sortie, i_entree, j_entree);
+                mettre_a_jour_potentiels(arbre, i_entree, j_entree, i_sortie, j_sortie,
+                                         marginal, pot_f, pot_c);
+            } else {
+                invalider_arbre_base(arbre);
+            }
+            liberer_adjacence(adj);
+
+            if (!remplace) {
+                trace("Avertissement : base non mise à jour (arc sortant introuvable). Reconstruction.\n");
+                liberer_base(b);
+                b = construire_base(s);
+            }
+        } else {
+            liberer_adjacence(adj);
+            trace("\n=== SOLUTION DÉJÀ OPTIMALE, PAS DE MARCHE-PIED ===\n");
+            break;
+        }
+
+    }
+
+    liberer_base(b);
+    liberer_arbre_base(arbre);
+    liberer_tarification(tarif);
+    free(pot_f);
+    free(pot_c);
+    res->nb_iterations = iteration - 1;
+    res->temps_marche_pied = time_spent_mp;
+}
+
+/*
+ * Contexte et point d'entrée ------------------------------------------------
+ */
+
+ContexteTransport *transport_creer_contexte(void)
+{
+    ContexteTransport *ctx = malloc(sizeof(ContexteTransport));
+    if (!ctx)
+        return NULL;
+
+    ctx->sortie.console = 0;
+    ctx->sortie.fichier = NULL;
+    ctx->detaille = 0;
+    ctx->nb_threads = 1;
+    ctx->delai_portefeuille = 0;
+    ctx->preresolution = 1;
+    ctx->tarification = TARIFICATION_DANTZIG;
+    ctx->tarification_imposee = 0;
+    ctx->table_choix = *table_choix_defaut();
+    ctx->arene = creer_arene((size_t)1 << 20);
+    if (!ctx->arene) {
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+void transport_detruire_contexte(ContexteTransport *ctx)
+{
+    if (!ctx) return;
+    detruire_arene(ctx->arene);
+    free(ctx);
+}
+
+void transport_definir_traces(ContexteTransport *ctx, int console, FILE *fichier)
+{
+    ctx->sortie.console = console;
+    ctx->sortie.fichier = fichier;
+}
+
+void transport_definir_detail(ContexteTransport *ctx, int detaille)
+{
+    ctx->detaille = detaille;
+}
+
+void transport_definir_threads(ContexteTransport *ctx, int nb_threads)
+{
+    ctx->nb_threads = (nb_threads < 0) ? 1 : nb_threads;
+}
+
+void transport_definir_delai_portefeuille(ContexteTransport *ctx, double secondes)
+{
+    ctx->delai_portefeuille = (secondes < 0) ? 0 : secondes;
+}
+
+void transport_definir_preresolution(ContexteTransport *ctx, int active)
+{
+    ctx->preresolution = active;
+}
+
+int transport_definir_tarification(ContexteTransport *ctx, const char *strategie)
+{
+    int t = tarification_par_nom(strategie);
+    if (t < 0)
+        return TRANSPORT_METHODE_INCONNUE;
+    ctx->tarification = t;
+    ctx->tarification_imposee = 1;
+    return TRANSPORT_OK;
+}
+
+int transport_charger_table_choix(ContexteTransport *ctx, const char *fichier)
+{
+    return charger_table_choix(&ctx->table_choix, fichier);
+}
+
+int transport_solve(ContexteTransport *ctx, const Probleme *p, const char *methode,
+                    ResultatTransport *res)
+{
+    int en_portefeuille = (strcmp(methode, TRANSPORT_PORTEFEUILLE) == 0);
+    int automatique = (strcmp(methode, TRANSPORT_AUTO) == 0);
+    const Heuristique *initiale = trouver_heuristique(methode);
+    if (!initiale && !en_portefeuille && !automatique)
+        return TRANSPORT_METHODE_INCONNUE;
+
+    memset(res, 0, sizeof(*res));
+    vider_arene(ctx->arene);
+
+    Solution *s = creer_solution_vide_dans(p, ctx->arene);
+    if (!s)
+        return TRANSPORT_MEMOIRE;
+
+    SortieTrace precedente = trace_sortie();
+    trace_rediriger(ctx->sortie);
+
+    double debut = temps_cpu();
+    double debut_reel = temps_reel();
+
+    // Problème effectivement résolu (r, solution sr) : p, ou sa réduction,
+    // dont la préparation compte dans le temps de la méthode initiale. Un
+    // petit problème part tel quel au chemin rapide, où elle coûterait plus
+    // qu'elle ne rapporte.
+    const Probleme *r = p;
+    Solution *sr = s;
+    Preresolution *pr = (ctx->preresolution && !est_petit(p)) ? preresoudre(p, ctx->arene) : NULL;
+    if (pr) {
+        sr = creer_solution_vide_dans(pr->reduit, ctx->arene);
+        if (!sr) {
+            trace_rediriger(precedente);
+            return TRANSPORT_MEMOIRE;
+        }
+        r = pr->reduit;
+        trace("\nPrérésolution : %d x %d → %d x %d%s\n",
+              p->nb_fournisseurs, p->nb_clients, r->nb_fournisseurs, r->nb_clients,
+              pr->couts_reduits ? ", coûts diminués des minima de ligne et de colonne" : "");
+        if (ctx->detaille)
+            afficher_probleme(r);
+    }
+    res->nb_fournisseurs_resolus = r->nb_fournisseurs;
+    res->nb_clients_resolus = r->nb_clients;
+
+    int strategie = ctx->tarification;
+    if (automatique) {
+        // Le calcul des caractéristiques compte dans le temps de la méthode initiale
+        Caracteristiques c;
+        calculer_caracteristiques(r, &c);
+        const RegleChoix *regle = choisir_regle(&ctx->table_choix, &c);
+        initiale = trouver_heuristique(regle->methode);
+        if (!ctx->tarification_imposee)
+            strategie = tarification_par_nom(regle->tarification);
+        trace("\nChoix automatique : taille %d, rapport %.2f, étendue %.2f, "
+              "dispersion des minima %.2f, déséquilibre %.2f, densité %.2f → %s, "
+              "tarification %s\n",
+              c.taille, c.rapport, c.etendue, c.dispersion_minima, c.desequilibre,
+              c.densite, initiale->nom, nom_tarification(strategie));
+    }
+    trace("\n=== MÉTHODE : %s ===\n", en_portefeuille ? "PORTEFEUILLE" : initiale->titre);
+    if (en_portefeuille) {
+        int hors_delai = 0;
+        initiale = portefeuille(r, sr, ctx->delai_portefeuille, &hors_delai);
+        if (!initiale) {
+            trace_rediriger(precedente);
+            return hors_delai ? TRANSPORT_ECHEANCE : TRANSPORT_MEMOIRE;
+        }
+    } else {
+        initiale->calculer(r, sr, ctx->nb_threads);
+    }
+    res->temps_initial = temps_cpu() - debut;
+    res->temps_initial_reel = temps_reel() - debut_reel;
+    if (en_portefeuille)
+        res->temps_initial = res->temps_initial_reel;
+    res->methode = initiale->nom;
+
+    unsigned long long octets_avant = octets_lus_couts(r);
+    int statut = TRANSPORT_OK;
+
+    if (ctx->detaille) {
+        resoudre_detaille(r, sr, strategie, res);
+    } else {
+        // Petits problèmes : chemin rapide sans allocation (petit_probleme.h)
+        double debut_petit = temps_cpu();
+        res->nb_iterations = optimiser_solution_petite(r, sr);
+        if (res->nb_iterations >= 0) {
+            res->temps_marche_pied = temps_cpu() - debut_petit;
+        } else {
+            res->temps_marche_pied = optimiser_par_marche_pied(r, sr, ctx->arene,
+                                                               strategie,
+                                                               &res->nb_iterations);
+            if (res->temps_marche_pied < 0)
+                statut = TRANSPORT_MEMOIRE;
+        }
+    }
+
+    res->octets_lus = octets_lus_couts(r) - octets_avant;
+    if (pr && statut == TRANSPORT_OK && postresoudre(pr, sr, s, ctx->arene) != 0)
+        statut = TRANSPORT_MEMOIRE;
+    res->solution = s;
+    res->cout_total = cout_total(p, s);
+
+    trace_rediriger(precedente);
+    return statut;
+}
@@ -0,0 +1,249 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "tarification.h"
+#include "couts.h"
+#include "tuiles.h"
+
+static const char *const noms_tarification[NB_TARIFICATIONS] = {
+    "dantzig", "blocs", "candidats"
+};
+
+const char *nom_tarification(int strategie)
+{
+    if (strategie < 0 || strategie >= NB_TARIFICATIONS)
+        return "?";
+    return noms_tarification[strategie];
+}
+
+int tarification_par_nom(const char *nom)
+{
+    for (int k = 0; k < NB_TARIFICATIONS; k++)
+        if (strcmp(nom, noms_tarification[k]) == 0)
+            return k;
+    return -1;
+}
+
+Tarification *creer_tarification(const Probleme *p, int strategie, Arene *a)
+{
+    int n = p->nb_fournisseurs;
+    double cases = est_creux(p) ? (double)p->nb_arcs_autorises
+                                : (double)n * p->nb_clients;
+    double par_ligne = cases / (n > 0 ? n : 1);
+    double racine = sqrt(cases);
+
+    Tarification *t = a ? arene_alloc(a, sizeof(Tarification)) : malloc(sizeof(Tarification));
+    if (!t)
+        return NULL;
+    memset(t, 0, sizeof(Tarification));
+    t->strategie = strategie;
+    t->arene = a;
+
+    // Blocs de √(cases) cases, en lignes entières
+    t->lignes_par_bloc = par_ligne > 0 ? (int)ceil(racine / par_ligne) : 1;
+    if (t->lignes_par_bloc < 1)
+        t->lignes_par_bloc = 1;
+
+    // Liste de √(cases)/4 arcs, re-tarifée au plus un dixième de sa taille
+    t->taille_liste = (int)(racine / 4);
+    if (t->taille_liste < 10)
+        t->taille_liste = 10;
+    if (t->taille_liste > n)
+        t->taille_liste = n > 0 ? n : 1;   // un arc par ligne au plus
+    t->mineures_max = t->taille_liste / 10;
+    if (t->mineures_max < 3)
+        t->mineures_max = 3;
+
+    size_t taille_tampon = (size_t)taille_tampon_couts(p) * sizeof(int);
+    size_t taille_candidats = (size_t)t->taille_liste * sizeof(*t->candidats);
+    if (a) {
+        t->tampon = arene_alloc(a, taille_tampon);
+        t->candidats = arene_alloc(a, taille_candidats);
+    } else {
+        t->tampon = malloc(taille_tampon);
+        t->candidats = malloc(taille_candidats);
+    }
+    if (!t->tampon || !t->candidats) {
+        liberer_tarification(t);
+        return NULL;
+    }
+    return t;
+}
+
+void liberer_tarification(Tarification *t)
+{
+    if (!t || t->arene)
+        return;
+    free(t->tampon);
+    free(t->candidats);
+    free(t);
+}
+
+static int exclure_arc_base(const void *ctx, int i, int j)
+{
+    return arc_dans_base((const Base *)ctx, i, j);
+}
+
+/* Plus petit coût marginal de la ligne i strictement inférieur à *meilleur,
+   hors base : met *meilleur à jour et renvoie la colonne, ou -1. */
+static int tarifer_ligne(const Tarification *t, const Probleme *p, const Base *b, int i,
+                         const long long *pot_f, const long long *pot_c,
+                         long long *meilleur)
+{
+    /* Variante creuse : on ne parcourt que les arcs autorisés */
+    if (est_creux(p)) {
+        int retenu = -1;
+        for (int k = p->debut_ligne[i]; k < p->debut_ligne[i + 1]; k++) {
+            int j = p->arc_client[k];
+            if (arc_dans_base(b, i, j))
+                continue;
+
+            long long marginal = p->arc_cout[k] - (pot_f[i] - pot_c[j]);
+            if (marginal < *meilleur) {
+                *meilleur = marginal;
+                retenu = j;
+            }
+        }
+        return retenu;
+    }
+
+    /* Les arcs de la base ne sont testés que pour les candidats améliorants */
+    entrer_tuile(p, i);
+    return marginal_min_ligne(p, i, pot_f[i], pot_c, t->tampon,
+                              meilleur, exclure_arc_base, b);
+}
+
+static int choisir_dantzig(Tarification *t, const Probleme *p, const Base *b,
+                           const long long *pot_f, const long long *pot_c,
+                           int *i_entree, int *j_entree)
+{
+    long long meilleur = 0;
+    int meilleur_i = -1, meilleur_j = -1;
+    for (int i = 0; i < p->nb_fournisseurs; i++) {
+        int j = tarifer_ligne(t, p, b, i, pot_f, pot_c, &meilleur);
+        if (j >= 0) {
+            meilleur_i = i;
+            meilleur_j = j;
+        }
+    }
+    if (meilleur_i < 0)
+        return 1;
+    *i_entree = meilleur_i;
+    *j_entree = meilleur_j;
+    return 0;
+}
+
+/* Blocs parcourus à la suite depuis celui qui suit le dernier pivot ; le
+   premier bloc qui contient un arc améliorant donne le meilleur des siens. */
+static int choisir_blocs(Tarification *t, const Probleme *p, const Base *b,
+                         const long long *pot_f, const long long *pot_c,
+                         int *i_entree, int *j_entree)
+{
+    int n = p->nb_fournisseurs;
+    int i = t->prochaine_ligne;
+    long long meilleur = 0;
+    int meilleur_i = -1, meilleur_j = -1;
+
+    for (int vues = 0; vues < n; ) {
+        for (int r = 0; r < t->lignes_par_bloc && vues < n; r++, vues++) {
+            int j = tarifer_ligne(t, p, b, i, pot_f, pot_c, &meilleur);
+            if (j >= 0) {
+                meilleur_i = i;
+                meilleur_j = j;
+            }
+            if (++i == n)
+                i = 0;
+        }
+        if (meilleur_i >= 0) {
+            t->prochaine_ligne = i;
+            *i_entree = meilleur_i;
+            *j_entree = meilleur_j;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Meilleur candidat de la liste (encore hors base et améliorant), retiré de
+   la liste ; les autres candidats qui ne sont plus améliorants en sortent. */
+static int extraire_candidat(Tarification *t, const Probleme *p, const Base *b,
+                             const long long *pot_f, const long long *pot_c,
+                             int *i_entree, int *j_entree)
+{
+    long long meilleur = 0;
+    int retenu = -1, garde = 0;
+    for (int k = 0; k < t->nb_candidats; k++) {
+        int i = t->candidats[k][0], j = t->candidats[k][1];
+        if (arc_dans_base(b, i, j))
+            continue;
+        long long marginal = cout_arc(p, i, j) - (pot_f[i] - pot_c[j]);
+        if (marginal >= 0)
+            continue;
+        if (marginal < meilleur) {
+            meilleur = marginal;
+            retenu = garde;
+        }
+        t->candidats[garde][0] = i;
+        t->candidats[garde][1] = j;
+        garde++;
+    }
+    t->nb_candidats = garde;
+    if (retenu < 0)
+        return 0;
+
+    *i_entree = t->candidats[retenu][0];
+    *j_entree = t->candidats[retenu][1];
+    t->nb_candidats--;
+    t->candidats[retenu][0] = t->candidats[t->nb_candidats][0];
+    t->candidats[retenu][1] = t->candidats[t->nb_candidats][1];
+    return 1;
+}
+
+static int choisir_candidats(Tarification *t, const Probleme *p, const Base *b,
+                             const long long *pot_f, const long long *pot_c,
+                             int *i_entree, int *j_entree)
+{
+    // Itération mineure : seule la liste est re-tarifée
+    if (t->nb_mineures < t->mineures_max &&
+        extraire_candidat(t, p, b, pot_f, pot_c, i_entree, j_entree)) {
+        t->nb_mineures++;
+        return 0;
+    }
+
+    // Rafraîchissement : meilleur arc améliorant de chaque ligne, à la suite
+    int n = p->nb_fournisseurs;
+    int i = t->prochaine_ligne;
+    t->nb_candidats = 0;
+    t->nb_mineures = 0;
+    for (int vues = 0; vues < n && t->nb_candidats < t->taille_liste; vues++) {
+        long long meilleur = 0;
+        int j = tarifer_ligne(t, p, b, i, pot_f, pot_c, &meilleur);
+        if (j >= 0) {
+            t->candidats[t->nb_candidats][0] = i;
+            t->candidats[t->nb_candidats][1] = j;
+            t->nb_candidats++;
+        }
+        if (++i == n)
+            i = 0;
+    }
+    t->prochaine_ligne = i;
+
+    if (!extraire_candidat(t, p, b, pot_f, pot_c, i_entree, j_entree))
+        return 1;   // aucune ligne n'a d'arc améliorant
+    t->nb_mineures++;
+    return 0;
+}
+
+int choisir_arc_entrant(Tarification *t, const Probleme *p, const Base *b,
+                        const long long *pot_f, const long long *pot_c,
+                        int *i_entree, int *j_entree)
+{
+    switch (t->strategie) {
+    case TARIFICATION_BLOCS:
+        return choisir_blocs(t, p, b, pot_f, pot_c, i_entree, j_entree);
+    case TARIFICATION_CANDIDATS:
+        return choisir_candidats(t, p, b, pot_f, pot_c, i_entree, j_entree);
+    default:
+        return choisir_dantzig(t, p, b, pot_f, pot_c, i_entree, j_entree);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef TARIFICATION_H
+#define TARIFICATION_H
+
+#include "problem.h"
+#include "base.h"
+#include "arene.h"
+
+/*
+ * Tarification du marche-pied : choix de l'arc entrant parmi les cases hors
+ * base de coût marginal a_ij - (u_i - v_j) strictement négatif.
+ *
+ * - TARIFICATION_DANTZIG : toutes les cases à chaque pivot, coût marginal le
+ *   plus négatif (première case à égalité, ligne par ligne) ;
+ * - TARIFICATION_BLOCS : les lignes sont groupées en blocs d'environ √(n·m)
+ *   cases (√ du nombre d'arcs autorisés en creux). Le parcours reprend au
+ *   bloc qui suit celui du pivot précédent et s'arrête au premier bloc qui
+ *   contient un arc améliorant (le meilleur du bloc) ;
+ * - TARIFICATION_CANDIDATS : tarification partielle multiple. Un
+ *   rafraîchissement parcourt les lignes à la suite et garde le meilleur
+ *   arc améliorant de chacune, jusqu'à remplir une liste courte ; les
+ *   pivots suivants ne re-tarifent que la liste, tant qu'elle donne un arc
+ *   améliorant et au plus mineures_max fois.
+ *
+ * Chaque stratégie ne conclut à l'optimalité qu'après un parcours complet
+ * sans arc améliorant : même coût optimal, suites de pivots différentes.
+ */
+
+enum {
+    TARIFICATION_DANTZIG = 0,
+    TARIFICATION_BLOCS = 1,
+    TARIFICATION_CANDIDATS = 2
+};
+#define NB_TARIFICATIONS 3
+
+// "dantzig", "blocs", "candidats" ; tarification_par_nom renvoie -1 pour un autre nom
+const char *nom_tarification(int strategie);
+int tarification_par_nom(const char *nom);
+
+typedef struct Tarification {
+    int strategie;
+    int lignes_par_bloc;     // blocs
+    int prochaine_ligne;     // blocs, candidats : reprise du parcours (circulaire)
+    int taille_liste;        // candidats
+    int mineures_max;
+    int nb_candidats;
+    int nb_mineures;         // re-tarifications de la liste depuis son rafraîchissement
+    int (*candidats)[2];     // (i, j)
+    int *tampon;             // noyaux de ligne (taille_tampon_couts)
+    struct Arene *arene;     // arène propriétaire, NULL : malloc
+} Tarification;
+
+Tarification *creer_tarification(const Probleme *p, int strategie, Arene *a);
+void liberer_tarification(Tarification *t);
+
+// Renvoie 1 si la base est optimale, 0 sinon avec l'arc entrant dans
+// (i_entree, j_entree)
+int choisir_arc_entrant(Tarification *t, const Probleme *p, const Base *b,
+                        const long long *pot_f, const long long *pot_c,
+                        int *i_entree, int *j_entree);
+
+#endif
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include "tas.h"
+
+// 1 si x doit passer avant y
+static int avant(const Tas *t, int x, int y)
+{
+    return (t->cle[x] < t->cle[y]) || (t->cle[x] == t->cle[y] && x < y);
+}
+
+static void echanger(Tas *t, int a, int b)
+{
+    int x = t->tas[a];
+    t->tas[a] = t->tas[b];
+    t->tas[b] = x;
+    t->position[t->tas[a]] = a;
+    t->position[t->tas[b]] = b;
+}
+
+static void remonter(Tas *t, int k)
+{
+    while (k > 0 && avant(t, t->tas[k], t->tas[(k - 1) / 2])) {
+        echanger(t, k, (k - 1) / 2);
+        k = (k - 1) / 2;
+    }
+}
+
+static void descendre(Tas *t, int k)
+{
+    while (1) {
+        int meilleur = k;
+        int gauche = 2 * k + 1, droite = 2 * k + 2;
+        if (gauche < t->taille && avant(t, t->tas[gauche], t->tas[meilleur]))
+            meilleur = gauche;
+        if (droite < t->taille && avant(t, t->tas[droite], t->tas[meilleur]))
+            meilleur = droite;
+        if (meilleur == k)
+            return;
+        echanger(t, k, meilleur);
+        k = meilleur;
+    }
+}
+
+int initialiser_tas(Tas *t, int capacite)
+{
+    t->capacite = capacite;
+    t->taille = 0;
+    t->tas = malloc((size_t)capacite * sizeof(int));
+    t->position = malloc((size_t)capacite * sizeof(int));
+    t->cle = malloc((size_t)capacite * sizeof(long long));
+    if (!t->tas || !t->position || !t->cle) {
+        liberer_tas(t);
+        return -1;
+    }
+    for (int x = 0; x < capacite; x++)
+        t->position[x] = -1;
+    return 0;
+}
+
+void liberer_tas(Tas *t)
+{
+    free(t->tas);
+    free(t->position);
+    free(t->cle);
+    t->tas = t->position = NULL;
+    t->cle = NULL;
+    t->taille = 0;
+}
+
+void tas_placer(Tas *t, int x, long long cle)
+{
+    t->cle[x] = cle;
+    int k = t->position[x];
+    if (k < 0) {
+        k = t->taille++;
+        t->tas[k] = x;
+        t->position[x] = k;
+        remonter(t, k);
+        return;
+    }
+    remonter(t, k);
+    descendre(t, t->position[x]);
+}
+
+void tas_retirer(Tas *t, int x)
+{
+    int k = t->position[x];
+    if (k < 0)
+        return;
+
+    int dernier = --t->taille;
+    if (k != dernier) {
+        echanger(t, k, dernier);
+        t->position[x] = -1;
+        remonter(t, k);
+        descendre(t, t->position[t->tas[k]]);
+    } else {
+        t->position[x] = -1;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef TAS_H
+#define TAS_H
+
+/*
+ * Tas indexé (file de priorité) sur les éléments 0 .. capacite-1, chacun
+ * présent au plus une fois avec une clé modifiable. Le sommet est l'élément
+ * de plus petite clé, et à clé égale le plus petit indice : l'ordre est
+ * total, donc la suite des sommets ne dépend pas de l'ordre des mises à jour.
+ * Pour un maximum, on range l'opposé de la valeur.
+ */
+
+typedef struct {
+    int capacite;
+    int taille;
+    int *tas;           // éléments rangés en tas binaire
+    int *position;      // position de chaque élément dans tas, -1 s'il est absent
+    long long *cle;
+} Tas;
+
+// Renvoie 0, ou -1 si l'allocation échoue
+int initialiser_tas(Tas *t, int capacite);
+void liberer_tas(Tas *t);
+
+// Insère x, ou modifie sa clé s'il est déjà présent
+void tas_placer(Tas *t, int x, long long cle);
+void tas_retirer(Tas *t, int x);
+
+static inline int tas_vide(const Tas *t)
+{
+    return t->taille == 0;
+}
+
+static inline int tas_sommet(const Tas *t)
+{
+    return t->tas[0];
+}
+
+static inline int tas_contient(const Tas *t, int x)
+{
+    return t->position[x] >= 0;
+}
+
+#endif
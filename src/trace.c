@@ -1,21 +1,37 @@
 #include "trace.h"
 #include <stdarg.h>
 
-FILE *trace_file = NULL;
+static _Thread_local SortieTrace sortie_courante = { 1, NULL };
+
+SortieTrace trace_sortie(void)
+{
+    return sortie_courante;
+}
+
+void trace_rediriger(SortieTrace sortie)
+{
+    sortie_courante = sortie;
+}
 
 void trace(const char *format, ...)
 {
     va_list args;
 
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
+    // Résolution muette : on ne formate même pas le message
+    if (!sortie_courante.console && !sortie_courante.fichier)
+        return;
+
+    if (sortie_courante.console) {
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
 
-    if (trace_file) {
+    if (sortie_courante.fichier) {
         va_start(args, format);
-        vfprintf(trace_file, format, args);
+        vfprintf(sortie_courante.fichier, format, args);
         va_end(args);
-        fflush(trace_file);
+        fflush(sortie_courante.fichier);
     }
 }
 
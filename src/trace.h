@@ -3,7 +3,16 @@
 
 #include <stdio.h>
 
-extern FILE *trace_file;
+// Destinations des traces. Elles sont propres à chaque thread : plusieurs
+// résolutions peuvent tourner en parallèle, chacune avec ses propres sorties.
+typedef struct {
+    int console;      // 1 : écrire aussi sur stdout
+    FILE *fichier;    // copie des traces (NULL : aucune)
+} SortieTrace;
+
+// Destinations courantes du thread (par défaut : console seule)
+SortieTrace trace_sortie(void);
+void trace_rediriger(SortieTrace sortie);
 
 void trace(const char *format, ...);
 int sntrace(char *buf, size_t size, const char *format, ...);
@@ -0,0 +1,99 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stdio.h>
+#include "problem.h"
+
+/*
+ * libtransport : résolution du problème de transport (proposition initiale
+ * puis optimisation par le marche-pied avec potentiels).
+ *
+ * Toute la résolution passe par un contexte opaque qui possède ses options,
+ * ses sorties de trace et sa mémoire de travail. Un contexte ne sert qu'à
+ * une résolution à la fois ; des contextes distincts peuvent résoudre en
+ * parallèle dans des threads différents, y compris sur le même problème
+ * (lu seulement, tant que la lecture par tuiles n'y est pas activée).
+ */
+
+typedef struct ContexteTransport ContexteTransport;
+
+typedef struct {
+    Solution *solution;          // proposition finale, possédée par le contexte :
+                                 // valide jusqu'au prochain transport_solve
+    long long cout_total;
+    int nb_iterations;           // passes de tarification du marche-pied (pivots + 1)
+    const char *methode;         // méthode initiale utilisée (retenue, en portefeuille)
+    double temps_initial;        // secondes CPU de la méthode initiale (thread appelant ;
+                                 // en portefeuille, secondes écoulées)
+    double temps_initial_reel;   // secondes écoulées de la méthode initiale (tous threads)
+    double temps_marche_pied;    // secondes CPU de l'optimisation
+    unsigned long long octets_lus;  // coûts lus par tuiles pendant l'optimisation
+    int nb_fournisseurs_resolus; // dimensions du problème résolu, après préresolution
+    int nb_clients_resolus;
+} ResultatTransport;
+
+enum {
+    TRANSPORT_OK = 0,
+    TRANSPORT_METHODE_INCONNUE = -1,
+    TRANSPORT_MEMOIRE = -2,
+    TRANSPORT_ECHEANCE = -3      // portefeuille : aucune proposition avant le délai
+};
+
+ContexteTransport *transport_creer_contexte(void);
+void transport_detruire_contexte(ContexteTransport *ctx);
+
+// Sorties des traces de la résolution : console (stdout) et/ou fichier.
+// Par défaut le contexte est muet.
+void transport_definir_traces(ContexteTransport *ctx, int console, FILE *fichier);
+
+// Résolution détaillée : affiche à chaque itération la base, les potentiels
+// et les coûts marginaux (comme le programme transport). Par défaut, la
+// résolution est compacte (sans affichage par itération).
+void transport_definir_detail(ContexteTransport *ctx, int detaille);
+
+// Threads de la méthode initiale (0 : un par cœur, 1 par défaut), utilisés par
+// Balas-Hammer. La proposition obtenue ne dépend pas de ce nombre.
+void transport_definir_threads(ContexteTransport *ctx, int nb_threads);
+
+// Mode portefeuille (portefeuille.h) : toutes les méthodes du registre en
+// parallèle, la proposition la moins chère part au marche-pied. Les méthodes
+// encore en cours sont annulées au plus tard après ce délai (0 : seulement
+// l'échéance relative au premier arrivé, par défaut) ; si aucune n'a fini,
+// transport_solve renvoie TRANSPORT_ECHEANCE.
+#define TRANSPORT_PORTEFEUILLE "portefeuille"
+void transport_definir_delai_portefeuille(ContexteTransport *ctx, double secondes);
+
+// Préresolution (preresolution.h, active par défaut) : quantités nulles
+// retirées, lignes et colonnes de coûts identiques fusionnées, coûts diminués
+// des minima de ligne et de colonne ; la proposition finale est reportée sur
+// le problème d'origine, de même coût optimal. Sans effet hors matrice dense
+// et sur les petits problèmes (petit_probleme.h).
+void transport_definir_preresolution(ContexteTransport *ctx, int active);
+
+// Tarification du marche-pied (tarification.h) : "dantzig" (toutes les cases
+// à chaque pivot, par défaut), "blocs" (premier bloc de √(n·m) cases qui
+// contient un arc améliorant) ou "candidats" (liste courte d'arcs
+// prometteurs, seule re-tarifée entre deux rafraîchissements). Même coût
+// optimal, nombre de pivots et temps différents ; le chemin rapide des petits
+// problèmes reste en Dantzig. Renvoie TRANSPORT_OK, ou
+// TRANSPORT_METHODE_INCONNUE pour un autre nom (réglage inchangé).
+int transport_definir_tarification(ContexteTransport *ctx, const char *strategie);
+
+// Choix automatique de la méthode initiale et de la tarification selon les
+// caractéristiques de l'instance (choix_methode.h). Une tarification fixée
+// par transport_definir_tarification l'emporte sur celle de la table.
+#define TRANSPORT_AUTO "auto"
+
+// Remplace la table de décision du contexte par celle du fichier (écrite par
+// complexite --calibrer). Renvoie TRANSPORT_OK, ou -1 (fichier illisible ou
+// règle invalide) en gardant la table précédente.
+int transport_charger_table_choix(ContexteTransport *ctx, const char *fichier);
+
+// Résout p avec la méthode initiale de ce nom ("no", "bh", "cm", "ml", "ru",
+// une méthode ajoutée au registre, voir heuristiques.h), TRANSPORT_AUTO ou
+// TRANSPORT_PORTEFEUILLE.
+// Renvoie TRANSPORT_OK et remplit *res, ou un code d'erreur négatif.
+int transport_solve(ContexteTransport *ctx, const Probleme *p, const char *methode,
+                    ResultatTransport *res);
+
+#endif
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "trace.h"
+#include "io.h"
+#include "lot.h"
+#include "couts_simd.h"
+
+static double horloge(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// Chemin rapide instance par instance ; renvoie le nombre de coûts différents
+// de ceux du lot (les passes peuvent différer sur un Nord-Ouest dégénéré)
+static int verifier(const LotProblemes *l, const long long *couts, const int *iterations)
+{
+    int ecarts = 0, passes_differentes = 0;
+    for (int k = 0; k < l->nb_instances; k++) {
+        if (iterations[k] < 0)
+            continue;
+        PetitProbleme pp;
+        FluxPetit flux;
+        extraire_instance(l, k, &pp);
+        nord_ouest_petit(&pp, flux);
+        int passes = optimiser_petit(&pp, flux);
+        if (passes < 0) {
+            trace("Instance %d : chemin rapide seul sans conclusion (borne de passes)\n", k);
+            ecarts++;
+            continue;
+        }
+        long long cout = cout_petit(&pp, flux);
+        if (cout != couts[k]) {
+            trace("Écart instance %d : lot %lld, seule %lld\n", k, couts[k], cout);
+            ecarts++;
+        }
+        passes_differentes += (passes != iterations[k]);
+    }
+    trace("Vérification : %d écart(s) de coût avec le chemin rapide seul, "
+          "%d instance(s) en un nombre de passes différent\n", ecarts, passes_differentes);
+    return ecarts;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        trace("Usage : %s <lot.txt> [--repetitions <r>] [--verifier] [--resume]\n", argv[0]);
+        return 1;
+    }
+
+    // --repetitions : résout le lot r fois pour mesurer le débit
+    // --verifier : compare chaque instance au chemin rapide seul
+    // --resume : n'affiche pas le résultat de chaque instance
+    int repetitions = 1, verification = 0, resume = 0;
+    for (int a = 2; a < argc; a++) {
+        if (strcmp(argv[a], "--repetitions") == 0 && a + 1 < argc) {
+            repetitions = atoi(argv[++a]);
+            if (repetitions < 1)
+                repetitions = 1;
+        } else if (strcmp(argv[a], "--verifier") == 0) {
+            verification = 1;
+        } else if (strcmp(argv[a], "--resume") == 0) {
+            resume = 1;
+        } else {
+            trace("Option inconnue : %s\n", argv[a]);
+            return 1;
+        }
+    }
+
+    ErreurLecture err;
+    LotProblemes *l = charger_lot_texte(argv[1], &err);
+    if (!l) {
+        trace("Erreur : %s:%d:%d : %s\n", argv[1], err.ligne, err.colonne, err.message);
+        return 1;
+    }
+
+    long long *couts = malloc(((size_t)l->nb_instances + 1) * sizeof(long long));
+    int *iterations = malloc(((size_t)l->nb_instances + 1) * sizeof(int));
+    if (!couts || !iterations) {
+        trace("Erreur : mémoire insuffisante.\n");
+        free(couts);
+        free(iterations);
+        liberer_lot(l);
+        return 1;
+    }
+
+    int resolues = 0;
+    double debut = horloge();
+    for (int r = 0; r < repetitions; r++)
+        resolues = resoudre_lot(l, couts, iterations);
+    double duree = horloge() - debut;
+
+    if (!resume) {
+        for (int k = 0; k < l->nb_instances; k++) {
+            if (iterations[k] == -1)
+                trace("Instance %d : déséquilibrée, ignorée\n", k);
+            else if (iterations[k] < 0)
+                trace("Instance %d : borne de passes atteinte, coût %lld non prouvé optimal\n",
+                      k, couts[k]);
+            else
+                trace("Instance %d : coût %lld, %d passes\n", k, couts[k], iterations[k]);
+        }
+    }
+
+    trace("\n%d instances %d x %d, %d résolues par groupes de %d voies (%s)\n",
+          l->nb_instances, l->nb_fournisseurs, l->nb_clients, resolues, LOT_VOIES,
+          simd_disponible() ? "AVX2" : "sans AVX2");
+    if (duree > 0)
+        trace("Temps : %.6f s pour %d répétition(s), %.0f instances/s\n",
+              duree, repetitions, (double)resolues * repetitions / duree);
+
+    int ecarts = 0;
+    if (verification)
+        ecarts = verifier(l, couts, iterations);
+
+    free(couts);
+    free(iterations);
+    liberer_lot(l);
+    return ecarts != 0;
+}
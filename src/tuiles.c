@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "tuiles.h"
+#include "arene.h"
+
+// Octets occupés par une ligne de coûts (pas compris)
+static size_t taille_ligne(const Probleme *p)
+{
+    return (size_t)p->pas_couts * (size_t)p->largeur_couts;
+}
+
+// Applique un conseil madvise aux lignes de la tuile t, arrondies aux pages
+static void conseiller_tuile(const Probleme *p, int t, int conseil)
+{
+    const struct Tuilage *tl = p->tuilage;
+    int premiere = t * tl->lignes_par_tuile;
+    if (t < 0 || premiere >= p->nb_fournisseurs)
+        return;
+
+    int fin = premiere + tl->lignes_par_tuile;
+    if (fin > p->nb_fournisseurs)
+        fin = p->nb_fournisseurs;
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t debut = (uintptr_t)ligne_couts(p, premiere);
+    uintptr_t limite = debut + (size_t)(fin - premiere) * taille_ligne(p);
+    debut &= ~(uintptr_t)(page - 1);
+
+    madvise((void *)debut, limite - debut, conseil);
+}
+
+int activer_tuilage(Probleme *p, size_t octets_par_tuile)
+{
+    if (!p->couts)
+        return -1;
+
+    struct Tuilage *tl = p->tuilage;
+    if (!tl)
+        tl = p->arene ? arene_alloc(p->arene, sizeof(struct Tuilage))
+                      : malloc(sizeof(struct Tuilage));
+    if (!tl)
+        return -1;
+
+    size_t lignes = octets_par_tuile / taille_ligne(p);
+    if (lignes < 1)
+        lignes = 1;
+    if (lignes > (size_t)p->nb_fournisseurs)
+        lignes = (size_t)p->nb_fournisseurs;
+
+    tl->lignes_par_tuile = (int)lignes;
+    tl->tuile_courante = -1;
+    tl->octets_lus = 0;
+    p->tuilage = tl;
+
+    // La lecture anticipée est pilotée tuile par tuile : on coupe celle du
+    // noyau, inutile (voire nuisible) pour les accès par colonne.
+    if (p->projection)
+        madvise(p->projection, p->taille_projection, MADV_RANDOM);
+
+    return 0;
+}
+
+void entrer_tuile(const Probleme *p, int i)
+{
+    struct Tuilage *tl = p->tuilage;
+    if (!tl)
+        return;
+
+    tl->octets_lus += taille_ligne(p);
+
+    int t = i / tl->lignes_par_tuile;
+    if (t == tl->tuile_courante)
+        return;
+
+    if (p->projection) {
+        if (tl->tuile_courante != t + 1)
+            conseiller_tuile(p, tl->tuile_courante, MADV_DONTNEED);
+        conseiller_tuile(p, t, MADV_WILLNEED);
+        conseiller_tuile(p, t + 1, MADV_WILLNEED);
+    }
+
+    tl->tuile_courante = t;
+}
+
+void compter_lignes_lues(const Probleme *p, int nb_lignes)
+{
+    if (p->tuilage)
+        p->tuilage->octets_lus += (unsigned long long)nb_lignes * taille_ligne(p);
+}
+
+unsigned long long octets_lus_couts(const Probleme *p)
+{
+    return p->tuilage ? p->tuilage->octets_lus : 0;
+}
@@ -0,0 +1,41 @@
+#ifndef TUILES_H
+#define TUILES_H
+
+#include "problem.h"
+
+/*
+ * Parcours de la matrice de coûts dense par tuiles de lignes consécutives,
+ * pour les instances dont la matrice dépasse la mémoire physique.
+ *
+ * Les boucles de tarification et de pénalités parcourent les lignes dans
+ * l'ordre et annoncent chaque ligne par entrer_tuile(). Au changement de
+ * tuile, si la matrice est projetée depuis un fichier binaire (mmap), on
+ * demande au noyau de lire la tuile suivante à l'avance (MADV_WILLNEED) et
+ * de libérer la précédente (MADV_DONTNEED) : seules deux tuiles restent
+ * résidentes. Les pages libérées sont relues depuis le fichier au besoin.
+ *
+ * Sur une matrice en mémoire, seul le compte des octets lus est tenu, ce qui
+ * permet de régler la taille des tuiles depuis l'étude de complexité.
+ */
+
+struct Tuilage {
+    int lignes_par_tuile;
+    int tuile_courante;              // -1 : aucun parcours en cours
+    unsigned long long octets_lus;   // volume de coûts parcouru (lignes annoncées) depuis l'activation
+};
+
+// Active le parcours par tuiles d'environ octets_par_tuile octets (au moins une ligne).
+// Renvoie -1 hors matrice dense ou si l'allocation échoue.
+int activer_tuilage(Probleme *p, size_t octets_par_tuile);
+
+// Annonce la lecture de la ligne i (sans effet si le tuilage est inactif)
+void entrer_tuile(const Probleme *p, int i);
+
+// Compte nb_lignes lignes lues en dehors d'un parcours par tuiles (lecture
+// répartie entre threads, par exemple), sans conseil au noyau
+void compter_lignes_lues(const Probleme *p, int nb_lignes);
+
+// Volume de coûts lu par tuiles (0 si le tuilage est inactif)
+unsigned long long octets_lus_couts(const Probleme *p);
+
+#endif
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+int pas_aligne(int nb_colonnes, size_t taille_elem)
+{
+    size_t par_ligne_cache = ALIGNEMENT_MATRICE / taille_elem;
+    if (par_ligne_cache == 0)
+        par_ligne_cache = 1;
+
+    size_t pas = ((size_t)nb_colonnes + par_ligne_cache - 1) / par_ligne_cache * par_ligne_cache;
+    if (pas == 0)
+        pas = par_ligne_cache;
+    return (int)pas;
+}
+
+void *allouer_bloc_aligne(size_t nb_lignes, size_t pas, size_t taille_elem)
+{
+    size_t taille = nb_lignes * pas * taille_elem;
+    if (taille == 0)
+        taille = ALIGNEMENT_MATRICE;
+
+    void *bloc = NULL;
+    if (posix_memalign(&bloc, ALIGNEMENT_MATRICE, taille) != 0)
+        return NULL;
+
+    memset(bloc, 0, taille);
+    return bloc;
+}
+
+void liberer_bloc_aligne(void *bloc)
+{
+    free(bloc);
+}
@@ -0,0 +1,18 @@
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <stddef.h>
+
+// Toutes les matrices (coûts, quantités) sont stockées dans un seul bloc
+// aligné sur 64 octets (une ligne de cache), avec un pas de ligne fixe.
+#define ALIGNEMENT_MATRICE 64
+
+// Nombre d'éléments par ligne pour que chaque ligne démarre sur une frontière de 64 octets
+int pas_aligne(int nb_colonnes, size_t taille_elem);
+
+// Alloue nb_lignes * pas éléments dans un bloc unique aligné, initialisé à 0
+void *allouer_bloc_aligne(size_t nb_lignes, size_t pas, size_t taille_elem);
+
+void liberer_bloc_aligne(void *bloc);
+
+#endif